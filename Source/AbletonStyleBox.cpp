@@ -11,10 +11,9 @@
 #include "AbletonStyleBox.h"
 
 
-CustomLookAndFeel::CustomLookAndFeel()
+CustomLookAndFeel::CustomLookAndFeel(juce::Typeface::Ptr typeface)
 {
-    auto font = juce::Typeface::createSystemTypefaceFor(BinaryData::ScopeOneRegular_ttf, BinaryData::ScopeOneRegular_ttfSize);
-    setDefaultSansSerifTypeface(font);
+    setDefaultSansSerifTypeface(typeface);
 }
 CustomLookAndFeel::~CustomLookAndFeel(){};
 
@@ -41,11 +40,61 @@ juce::Label* CustomLookAndFeel::createSliderTextBox (juce::Slider& slider)
     return l;
 }
 
+SharedEditorResources::~SharedEditorResources()
+{
+    // 에디터가 기본 룩앤필로 지정해 두었으면 해제하기 전에 되돌림
+    if (lookAndFeel != nullptr && &juce::LookAndFeel::getDefaultLookAndFeel() == lookAndFeel.get())
+        juce::LookAndFeel::setDefaultLookAndFeel(nullptr);
+}
+
+juce::Typeface::Ptr SharedEditorResources::getTypeface()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    
+    if (typeface == nullptr)
+        typeface = juce::Typeface::createSystemTypefaceFor(BinaryData::ScopeOneRegular_ttf, BinaryData::ScopeOneRegular_ttfSize);
+    
+    return typeface;
+}
+
+CustomLookAndFeel& SharedEditorResources::getLookAndFeel()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    
+    if (lookAndFeel == nullptr)
+        lookAndFeel = std::make_unique<CustomLookAndFeel>(getTypeface());
+    
+    return *lookAndFeel;
+}
+
+const juce::Drawable& SharedEditorResources::getIcon(Icon icon)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    
+    auto& drawable = icons[(size_t) icon];
+    
+    if (drawable == nullptr)
+    {
+        switch (icon)
+        {
+            case Icon_LowCut:  drawable = juce::Drawable::createFromImageData(BinaryData::highpass_svg, BinaryData::highpass_svgSize); break;
+            case Icon_Peak:    drawable = juce::Drawable::createFromImageData(BinaryData::bell_svg, BinaryData::bell_svgSize); break;
+            case Icon_HighCut: drawable = juce::Drawable::createFromImageData(BinaryData::lowpass_svg, BinaryData::lowpass_svgSize); break;
+            case numIcons:
+            default:           jassertfalse; break;
+        }
+        
+        jassert(drawable != nullptr);
+    }
+    
+    return *drawable;
+}
+
 AbletonStyleBox::AbletonStyleBox(){}
 AbletonStyleBox::AbletonStyleBox(juce::RangedAudioParameter& rap, const juce::String& unitSuffix) : param(&rap),suffix(unitSuffix)
 {
     
-    setLookAndFeel(&customLookAndFeel);
+    setLookAndFeel(&sharedResources->getLookAndFeel());
     
     setTextValueSuffix(suffix);
     setSliderStyle(juce::Slider::SliderStyle::LinearBar);
@@ -16,7 +16,7 @@
 class CustomLookAndFeel : public juce::LookAndFeel_V4
 {
 public:
-    CustomLookAndFeel();
+    explicit CustomLookAndFeel(juce::Typeface::Ptr typeface);
     ~CustomLookAndFeel();
     
 
@@ -28,6 +28,36 @@ private:
 };
 
 
+// 모든 에디터가 함께 쓰는 폰트, 룩앤필, 아이콘
+// juce::SharedResourcePointer 로 잡으면 프로세스에 하나만 생기고 마지막 참조가 사라질 때 해제됨
+// 각 항목은 처음 요청될 때 만듦 (메시지 스레드 전용)
+class SharedEditorResources
+{
+public:
+    enum Icon
+    {
+        Icon_LowCut,
+        Icon_Peak,
+        Icon_HighCut,
+        numIcons
+    };
+    
+    SharedEditorResources() = default;
+    ~SharedEditorResources();
+    
+    juce::Typeface::Ptr getTypeface();
+    CustomLookAndFeel& getLookAndFeel();
+    const juce::Drawable& getIcon(Icon icon);
+    
+private:
+    juce::Typeface::Ptr typeface;
+    std::unique_ptr<CustomLookAndFeel> lookAndFeel;
+    std::array<std::unique_ptr<juce::Drawable>, numIcons> icons;
+    
+    JUCE_DECLARE_NON_COPYABLE (SharedEditorResources)
+};
+
+
 class AbletonStyleBox : public juce::Slider
 {
 public:
@@ -42,7 +72,7 @@ public:
     void mouseUp (const juce::MouseEvent& event) override;
     
 private:
-    CustomLookAndFeel customLookAndFeel;
+    juce::SharedResourcePointer<SharedEditorResources> sharedResources;
     
     juce::RangedAudioParameter* param;
     juce::String suffix;
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    BiquadDesign.h
+    Created: 17 Oct 2026 11:58:27pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDFilterEngine.h"
+
+
+// 힙을 쓰지 않는 바이쿼드 설계
+// juce::dsp::FilterDesign, IIR::Coefficients 의 make* 와 같은 식이지만 결과를 호출한 쪽의 저장소에 바로 씀
+// (JUCE 쪽은 호출마다 Coefficients 객체와 배열을 할당)
+// 같은 입력에서 JUCE 설계와의 계수 차이는 1e-9 이하 (Benchmark 의 정확도 검사로 확인)
+
+// 버터워스 극점 표, 차수 N 의 2차 섹션 i 에 대한 1 / Q = 2 cos(pi (2i + 1 + N % 2) / 2N)
+// 홀수 차수의 1차 섹션은 표에 없음
+namespace ButterworthPoles
+{
+    constexpr int maxOrder = 8;
+
+    constexpr double inverseQ[maxOrder + 1][maxOrder / 2] =
+    {
+        { },
+        { },
+        { 1.41421356237309504880 },
+        { 1.0 },
+        { 1.84775906502257351225, 0.76536686473017954346 },
+        { 1.61803398874989484820, 0.61803398874989484820 },
+        { 1.93185165257813657349, 1.41421356237309504880, 0.51763809020504152470 },
+        { 1.80193773580483825247, 1.24697960371746706105, 0.44504186791262880858 },
+        { 1.96157056080646089825, 1.66293922460509047415, 1.11114046603920444948, 0.39018064403225653569 }
+    };
+
+    // 극점 각도가 커질수록 1 / Q 는 (0, 2) 안에서 줄어들어야 함
+    constexpr bool isValidTable() noexcept
+    {
+        for (int order = 2; order <= maxOrder; ++order)
+        {
+            for (int i = 0; i < order / 2; ++i)
+            {
+                const auto value = inverseQ[order][i];
+
+                if (value <= 0.0 || value >= 2.0 || (i > 0 && value >= inverseQ[order][i - 1]))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(isValidTable(), "Butterworth pole table is out of order");
+}
+
+// a0 로 나눠서 a0 = 1 로 맞춤
+template <typename SampleType>
+BiquadCoefficients<SampleType> makeNormalisedBiquad(double b0, double b1, double b2,
+                                                     double a0, double a1, double a2) noexcept
+{
+    const auto scale = 1.0 / a0;
+
+    BiquadCoefficients<SampleType> section;
+    section.b0 = static_cast<SampleType>(b0 * scale);
+    section.b1 = static_cast<SampleType>(b1 * scale);
+    section.b2 = static_cast<SampleType>(b2 * scale);
+    section.a1 = static_cast<SampleType>(a1 * scale);
+    section.a2 = static_cast<SampleType>(a2 * scale);
+    return section;
+}
+
+// order 차 버터워스 하이패스/로우패스를 섹션으로 나눠 씀, 섹션 수를 반환
+// designIIR...HighOrderButterworthMethod 와 같이 홀수 차수면 1차 섹션이 맨 앞
+template <typename SampleType>
+int makeBiquadButterworth(bool isHighPass, double frequency, int order, double sampleRate,
+                          BiquadCoefficients<SampleType>* sections, int maxSections) noexcept
+{
+    jassert(order >= 1 && order <= ButterworthPoles::maxOrder);
+
+    const auto numSections = (order + 1) / 2;
+    jassert(numSections <= maxSections);
+    juce::ignoreUnused(maxSections);
+
+    // 모든 섹션이 같은 컷오프를 쓰므로 tan 은 한 번만
+    const auto t = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+    auto* section = sections;
+
+    if (order % 2 == 1)
+    {
+        *section++ = isHighPass ? makeNormalisedBiquad<SampleType>(1.0, -1.0, 0.0, t + 1.0, t - 1.0, 0.0)
+                                : makeNormalisedBiquad<SampleType>(t, t, 0.0, t + 1.0, t - 1.0, 0.0);
+    }
+
+    const auto n = 1.0 / t;
+    const auto nSquared = n * n;
+
+    for (int i = 0; i < order / 2; ++i)
+    {
+        const auto invQ = ButterworthPoles::inverseQ[order][i];
+        const auto c1 = 1.0 / (1.0 + invQ * n + nSquared);
+        const auto b0 = isHighPass ? c1 * nSquared : c1;
+
+        section->b0 = static_cast<SampleType>(b0);
+        section->b1 = static_cast<SampleType>(isHighPass ? -2.0 * b0 : 2.0 * b0);
+        section->b2 = static_cast<SampleType>(b0);
+        section->a1 = static_cast<SampleType>(c1 * 2.0 * (1.0 - nSquared));
+        section->a2 = static_cast<SampleType>(c1 * (1.0 - invQ * n + nSquared));
+        ++section;
+    }
+
+    return numSections;
+}
+
+// 피크(벨), gainFactor 는 선형 이득
+template <typename SampleType>
+BiquadCoefficients<SampleType> makeBiquadPeak(double frequency, double quality, double gainFactor, double sampleRate) noexcept
+{
+    const auto A = std::sqrt(juce::jmax(0.0, gainFactor));
+    const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const auto alpha = std::sin(omega) / (quality * 2.0);
+    const auto c2 = -2.0 * std::cos(omega);
+
+    return makeNormalisedBiquad<SampleType>(1.0 + alpha * A, c2, 1.0 - alpha * A,
+                                            1.0 + alpha / A, c2, 1.0 - alpha / A);
+}
+
+template <typename SampleType>
+BiquadCoefficients<SampleType> makeBiquadLowShelf(double frequency, double quality, double gainFactor, double sampleRate) noexcept
+{
+    const auto A = std::sqrt(juce::jmax(0.0, gainFactor));
+    const auto aMinus1 = A - 1.0;
+    const auto aPlus1 = A + 1.0;
+    const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const auto cosOmega = std::cos(omega);
+    const auto beta = std::sin(omega) * std::sqrt(A) / quality;
+    const auto aMinus1TimesCos = aMinus1 * cosOmega;
+
+    return makeNormalisedBiquad<SampleType>(A * (aPlus1 - aMinus1TimesCos + beta),
+                                            A * 2.0 * (aMinus1 - aPlus1 * cosOmega),
+                                            A * (aPlus1 - aMinus1TimesCos - beta),
+                                            aPlus1 + aMinus1TimesCos + beta,
+                                            -2.0 * (aMinus1 + aPlus1 * cosOmega),
+                                            aPlus1 + aMinus1TimesCos - beta);
+}
+
+template <typename SampleType>
+BiquadCoefficients<SampleType> makeBiquadHighShelf(double frequency, double quality, double gainFactor, double sampleRate) noexcept
+{
+    const auto A = std::sqrt(juce::jmax(0.0, gainFactor));
+    const auto aMinus1 = A - 1.0;
+    const auto aPlus1 = A + 1.0;
+    const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const auto cosOmega = std::cos(omega);
+    const auto beta = std::sin(omega) * std::sqrt(A) / quality;
+    const auto aMinus1TimesCos = aMinus1 * cosOmega;
+
+    return makeNormalisedBiquad<SampleType>(A * (aPlus1 + aMinus1TimesCos + beta),
+                                            A * -2.0 * (aMinus1 + aPlus1 * cosOmega),
+                                            A * (aPlus1 + aMinus1TimesCos - beta),
+                                            aPlus1 - aMinus1TimesCos + beta,
+                                            2.0 * (aMinus1 - aPlus1 * cosOmega),
+                                            aPlus1 - aMinus1TimesCos - beta);
+}
+
+template <typename SampleType>
+BiquadCoefficients<SampleType> makeBiquadNotch(double frequency, double quality, double sampleRate) noexcept
+{
+    const auto n = 1.0 / std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+    const auto nSquared = n * n;
+    const auto invQ = 1.0 / quality;
+    const auto c1 = 1.0 / (1.0 + n * invQ + nSquared);
+    const auto b0 = c1 * (1.0 + nSquared);
+    const auto b1 = 2.0 * c1 * (1.0 - nSquared);
+
+    BiquadCoefficients<SampleType> section;
+    section.b0 = static_cast<SampleType>(b0);
+    section.b1 = static_cast<SampleType>(b1);
+    section.b2 = static_cast<SampleType>(b0);
+    section.a1 = static_cast<SampleType>(b1);
+    section.a2 = static_cast<SampleType>(c1 * (1.0 - n * invQ + nSquared));
+    return section;
+}
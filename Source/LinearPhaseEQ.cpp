@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    LinearPhaseEQ.cpp
+    Created: 17 Oct 2026 4:47:19pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseEQ.h"
+
+
+void LinearPhaseEQ::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    const juce::ScopedLock sl(engineLock);
+
+    preparedSpec = spec;
+    sampleRate = spec.sampleRate;
+
+    // 20 Hz 로우컷을 표현할 수 있을 만큼의 주파수 해상도
+    kernelSize = sampleRate > 100000.0 ? 32768 : sampleRate > 50000.0 ? 16384 : 8192;
+
+    const auto numPairs = (spec.numChannels + 1) / 2;
+
+    conversionBuffer.setSize((int) spec.numChannels, (int) spec.maximumBlockSize);
+
+    for (int partitionIndex = 0; partitionIndex < numPartitionSizes; ++partitionIndex)
+    {
+        auto& engines = convolutions[(size_t) partitionIndex];
+        engines.clear();
+
+        for (size_t pair = 0; pair < numPairs; ++pair)
+        {
+            auto convolution = std::make_unique<juce::dsp::Convolution>(juce::dsp::Convolution::Latency { getPartitionSize(partitionIndex) },
+                                                                         messageQueue);
+
+            convolution->prepare(getPairSpec(spec, pair));
+
+            engines.push_back(std::move(convolution));
+        }
+    }
+}
+
+void LinearPhaseEQ::loadPendingKernels()
+{
+    const juce::ScopedLock sl(engineLock);
+
+    // juce::dsp::Convolution::prepare 는 큐에 남은 로드 요청을 이 스레드에서 모두 처리한 뒤
+    // 새 엔진을 바로 현재 엔진으로 삼으므로 백그라운드 로드와 크로스페이드를 기다릴 필요가 없음
+    for (auto& engines : convolutions)
+        for (size_t pair = 0; pair < engines.size(); ++pair)
+            engines[pair]->prepare(getPairSpec(preparedSpec, pair));
+}
+
+juce::dsp::ProcessSpec LinearPhaseEQ::getPairSpec(const juce::dsp::ProcessSpec& spec, size_t pair)
+{
+    auto pairSpec = spec;
+    pairSpec.numChannels = juce::jmin((juce::uint32) 2, spec.numChannels - (juce::uint32) pair * 2);
+    return pairSpec;
+}
+
+void LinearPhaseEQ::reset(int partitionIndex)
+{
+    for (auto& convolution : convolutions[(size_t) partitionIndex])
+        convolution->reset();
+}
+
+void LinearPhaseEQ::process(juce::dsp::AudioBlock<float>& block, int partitionIndex)
+{
+    auto& engines = convolutions[(size_t) partitionIndex];
+    const auto numChannels = block.getNumChannels();
+    const auto midSide = numChannels == 2;
+
+    if (midSide)
+        encodeMidSide(block);
+
+    for (size_t pair = 0; pair < engines.size(); ++pair)
+    {
+        const auto firstChannel = pair * 2;
+
+        if (firstChannel >= numChannels)
+            break;
+
+        auto pairBlock = block.getSubsetChannelBlock(firstChannel, juce::jmin((size_t) 2, numChannels - firstChannel));
+        juce::dsp::ProcessContextReplacing<float> context(pairBlock);
+        engines[pair]->process(context);
+    }
+
+    if (midSide)
+        decodeMidSide(block);
+}
+
+// SIMDFilterEngine 과 같은 정의, M = (L + R) / 2, S = (L - R) / 2
+void LinearPhaseEQ::encodeMidSide(juce::dsp::AudioBlock<float>& block)
+{
+    auto* left = block.getChannelPointer(0);
+    auto* right = block.getChannelPointer(1);
+
+    for (size_t i = 0; i < block.getNumSamples(); ++i)
+    {
+        const auto mid = 0.5f * (left[i] + right[i]);
+        const auto side = 0.5f * (left[i] - right[i]);
+        left[i] = mid;
+        right[i] = side;
+    }
+}
+
+void LinearPhaseEQ::decodeMidSide(juce::dsp::AudioBlock<float>& block)
+{
+    auto* mid = block.getChannelPointer(0);
+    auto* side = block.getChannelPointer(1);
+
+    for (size_t i = 0; i < block.getNumSamples(); ++i)
+    {
+        const auto left = mid[i] + side[i];
+        const auto right = mid[i] - side[i];
+        mid[i] = left;
+        side[i] = right;
+    }
+}
+
+void LinearPhaseEQ::process(juce::dsp::AudioBlock<double>& block, int partitionIndex)
+{
+    const auto numChannels = juce::jmin((int) block.getNumChannels(), conversionBuffer.getNumChannels());
+    const auto numSamples = (int) block.getNumSamples();
+
+    jassert(numSamples <= conversionBuffer.getNumSamples());
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* source = block.getChannelPointer((size_t) ch);
+        auto* destination = conversionBuffer.getWritePointer(ch);
+
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = static_cast<float>(source[i]);
+    }
+
+    juce::dsp::AudioBlock<float> floatBlock(conversionBuffer.getArrayOfWritePointers(), (size_t) numChannels, (size_t) numSamples);
+    process(floatBlock, partitionIndex);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* source = conversionBuffer.getReadPointer(ch);
+        auto* destination = block.getChannelPointer((size_t) ch);
+
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = static_cast<double>(source[i]);
+    }
+}
+
+int LinearPhaseEQ::getLatencySamples(int partitionIndex) const
+{
+    const auto& engines = convolutions[(size_t) partitionIndex];
+
+    if (engines.empty())
+        return 0;
+
+    return kernelSize / 2 + engines.front()->getLatency();
+}
+
+void LinearPhaseEQ::updateKernel(const BiquadCoefficients<double>* sections, int numSections, double designSampleRate)
+{
+    const juce::ScopedLock sl(engineLock);
+
+    if (kernelSize == 0 || sampleRate <= 0.0)
+        return;
+
+    juce::AudioBuffer<float> kernel(1, kernelSize);
+    createKernel(sections, numSections, designSampleRate, kernel, 0);
+    loadKernel(kernel, juce::dsp::Convolution::Stereo::no);
+}
+
+void LinearPhaseEQ::updateKernel(const BiquadCoefficients<double>* midSections, int numMidSections,
+                                 const BiquadCoefficients<double>* sideSections, int numSideSections, double designSampleRate)
+{
+    const juce::ScopedLock sl(engineLock);
+
+    if (kernelSize == 0 || sampleRate <= 0.0)
+        return;
+
+    // 채널 쌍이 하나뿐일 때만 Mid/Side 를 쓸 수 있음
+    jassert(preparedSpec.numChannels == 2);
+
+    juce::AudioBuffer<float> kernel(2, kernelSize);
+    createKernel(midSections, numMidSections, designSampleRate, kernel, 0);
+    createKernel(sideSections, numSideSections, designSampleRate, kernel, 1);
+    loadKernel(kernel, juce::dsp::Convolution::Stereo::yes);
+}
+
+void LinearPhaseEQ::createKernel(const BiquadCoefficients<double>* sections, int numSections, double designSampleRate,
+                                 juce::AudioBuffer<float>& destination, int channel) const
+{
+    juce::dsp::FFT fft(juce::roundToInt(std::log2(kernelSize)));
+    std::vector<float> spectrum((size_t) kernelSize * 2, 0.0f);
+
+    // IIR 과 같은 진폭, 위상은 커널 가운데(N/2)만큼 지연된 선형 위상 e^(-j pi k) = (-1)^k
+    // 진폭은 설계에 쓰인 (오버샘플링된) 레이트의 계수로 계산하므로 나이퀴스트 근처의 왜곡도 그대로 따라감
+    for (int k = 0; k <= kernelSize / 2; ++k)
+    {
+        const auto frequency = k * sampleRate / kernelSize;
+        auto magnitude = 1.0;
+
+        for (int i = 0; i < numSections; ++i)
+            magnitude *= getMagnitudeForFrequency(sections[i], frequency, designSampleRate);
+
+        spectrum[(size_t) k * 2] = (float) (k % 2 == 0 ? magnitude : -magnitude);
+    }
+
+    fft.performRealOnlyInverseTransform(spectrum.data());
+
+    // 양 끝의 잘림을 부드럽게
+    std::vector<float> window((size_t) kernelSize);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), (size_t) kernelSize,
+                                                             juce::dsp::WindowingFunction<float>::blackman, false);
+
+    juce::FloatVectorOperations::multiply(destination.getWritePointer(channel), spectrum.data(), window.data(), kernelSize);
+}
+
+void LinearPhaseEQ::loadKernel(const juce::AudioBuffer<float>& kernel, juce::dsp::Convolution::Stereo stereo)
+{
+    // 엔진마다 커널 사본을 넘기면 juce::dsp::Convolution 이 백그라운드에서 로드하고 크로스페이드
+    for (auto& engines : convolutions)
+    {
+        for (auto& convolution : engines)
+        {
+            juce::AudioBuffer<float> copy(kernel);
+            convolution->loadImpulseResponse(std::move(copy), sampleRate, stereo,
+                                             juce::dsp::Convolution::Trim::no,
+                                             juce::dsp::Convolution::Normalise::no);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    LinearPhaseEQ.h
+    Created: 17 Oct 2026 4:47:19pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDFilterEngine.h"
+
+
+// 마스터링용 선형 위상 모드
+// 현재 IIR 설계의 진폭 응답으로부터 FIR 커널을 만들고 균일 분할(uniformly partitioned) 컨볼루션으로 처리
+// 커널 생성은 설계 스레드에서, 교체 시 크로스페이드는 juce::dsp::Convolution 이 처리한다
+class LinearPhaseEQ
+{
+public:
+    // 분할 크기가 작을수록 지연이 짧고 CPU 를 더 씀
+    static constexpr int numPartitionSizes = 3;
+    static constexpr int getPartitionSize(int partitionIndex) { return 256 << (2 * partitionIndex); }
+
+    LinearPhaseEQ() = default;
+
+    // prepareToPlay 에서 호출, 분할 크기마다 채널 쌍 수만큼 컨볼루션 엔진을 만듦
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    // 오디오 스레드, 다른 분할 크기로 전환할 때 이전 상태를 지움
+    void reset(int partitionIndex);
+    void process(juce::dsp::AudioBlock<float>& block, int partitionIndex);
+
+    // juce::dsp::Convolution 은 float 전용이므로 double 경로는 미리 잡아 둔 버퍼로 변환해서 처리
+    void process(juce::dsp::AudioBlock<double>& block, int partitionIndex);
+
+    // 커널의 절반(선형 위상의 군지연) + 분할 지연
+    int getLatencySamples(int partitionIndex) const;
+
+    // 설계 스레드에서 호출, 섹션들의 진폭 응답으로 커널을 만들어 모든 엔진에 로드
+    void updateKernel(const BiquadCoefficients<double>* sections, int numSections, double designSampleRate);
+
+    // Mid/Side 용, Mid 와 Side 에 적용되는 섹션으로 커널을 따로 만들어 채널 0 / 1 에 로드 (2채널일 때만)
+    void updateKernel(const BiquadCoefficients<double>* midSections, int numMidSections,
+                      const BiquadCoefficients<double>* sideSections, int numSideSections, double designSampleRate);
+
+    // updateKernel 로 넘긴 커널을 호출한 스레드에서 바로 로드하고 크로스페이드 없이 교체
+    // 엔진 상태도 지워지므로 prepareToPlay 나 오프라인 렌더에서만 호출
+    void loadPendingKernels();
+
+private:
+    juce::dsp::ConvolutionMessageQueue messageQueue;
+
+    // juce::dsp::Convolution 은 최대 2채널이므로 채널 쌍마다 하나씩
+    using ConvolutionArray = std::vector<std::unique_ptr<juce::dsp::Convolution>>;
+    std::array<ConvolutionArray, numPartitionSizes> convolutions;
+
+    static juce::dsp::ProcessSpec getPairSpec(const juce::dsp::ProcessSpec& spec, size_t pair);
+
+    // engineLock 을 잡은 채로 호출, 진폭 응답으로 선형 위상 커널 하나를 만들어 destination 의 채널에 씀
+    void createKernel(const BiquadCoefficients<double>* sections, int numSections, double designSampleRate,
+                      juce::AudioBuffer<float>& destination, int channel) const;
+
+    void loadKernel(const juce::AudioBuffer<float>& kernel, juce::dsp::Convolution::Stereo stereo);
+
+    // 2채널이면 항상 M/S 로 바꿔서 컨볼루션, L/R 에서는 두 채널의 커널이 같으므로 결과도 같음
+    // 인코딩이 모드와 상관없이 같으므로 커널 교체 크로스페이드 중에도 이전 커널이 맞는 신호에 걸림
+    static void encodeMidSide(juce::dsp::AudioBlock<float>& block);
+    static void decodeMidSide(juce::dsp::AudioBlock<float>& block);
+
+    // prepare 와 updateKernel 사이의 직렬화용, 오디오 스레드는 잡지 않음
+    juce::CriticalSection engineLock;
+
+    juce::dsp::ProcessSpec preparedSpec {};
+    double sampleRate = 0.0;
+    int kernelSize = 0;
+
+    juce::AudioBuffer<float> conversionBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LinearPhaseEQ)
+};
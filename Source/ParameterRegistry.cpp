@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    ParameterRegistry.cpp
+    Created: 17 Oct 2026 11:41:06pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#include "ParameterRegistry.h"
+#include "LinearPhaseEQ.h"
+
+
+namespace
+{
+    constexpr bool isDecimal(const char* text, int value) noexcept
+    {
+        int parsed = 0;
+
+        for (; *text != 0; ++text)
+        {
+            if (*text < '0' || *text > '9')
+                return false;
+
+            parsed = parsed * 10 + (*text - '0');
+        }
+
+        return parsed == value;
+    }
+
+    // 선형 위상 선택지는 "Off" 뒤에 LinearPhaseEQ 의 분할 크기가 순서대로 와야 함
+    constexpr bool matchesPartitionSizes() noexcept
+    {
+        if (std::size(ParameterChoices::linearPhase) != (size_t) LinearPhaseEQ::numPartitionSizes + 1)
+            return false;
+
+        for (int i = 0; i < LinearPhaseEQ::numPartitionSizes; ++i)
+            if (! isDecimal(ParameterChoices::linearPhase[i + 1], LinearPhaseEQ::getPartitionSize(i)))
+                return false;
+
+        return true;
+    }
+
+    static_assert(matchesPartitionSizes(), "Linear Phase choices must match LinearPhaseEQ partition sizes");
+
+    std::unique_ptr<juce::RangedAudioParameter> makeParameter(const ParameterSpec& spec, const juce::String& id, float defaultValue)
+    {
+        if (spec.isChoice())
+        {
+            juce::StringArray choices;
+
+            for (int i = 0; i < spec.numChoices; ++i)
+                choices.add(spec.choices[i]);
+
+            return std::make_unique<juce::AudioParameterChoice>(id, id, choices, (int) defaultValue);
+        }
+
+        return std::make_unique<juce::AudioParameterFloat>(id,
+                                                           id,
+                                                           juce::NormalisableRange<float>(spec.minimum, spec.maximum, spec.interval, spec.skew),
+                                                           defaultValue);
+    }
+
+    void addParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+            layout.add(makeParameter(parameterSpecs[(size_t) i], parameterSpecs[(size_t) i].id, parameterSpecs[(size_t) i].defaultValue));
+    }
+
+    void addBandParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, int begin, int end)
+    {
+        for (int band = 0; band < numExtraBands; ++band)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                const auto parameter = static_cast<BandParameterIndex>(i);
+                const auto& spec = bandParameterSpecs[(size_t) i];
+                const auto defaultValue = parameter == BandParameter_Freq ? getBandDefaultFreq(band) : spec.defaultValue;
+
+                layout.add(makeParameter(spec, getBandParameterID(band, parameter), defaultValue));
+            }
+        }
+    }
+}
+
+const juce::String& getBandParameterID(int extraBand, BandParameterIndex parameter)
+{
+    static const auto ids = []
+    {
+        std::array<std::array<juce::String, numBandParameters>, numExtraBands> result;
+
+        for (int band = 0; band < numExtraBands; ++band)
+        {
+            const auto prefix = "Band " + juce::String(firstExtraBand + band + 1) + " ";
+
+            for (int i = 0; i < numBandParameters; ++i)
+                result[(size_t) band][(size_t) i] = prefix + bandParameterSpecs[(size_t) i].id;
+        }
+
+        return result;
+    }();
+
+    return ids[(size_t) extraBand][(size_t) parameter];
+}
+
+float getBandDefaultFreq(int extraBand)
+{
+    return std::round(20.f * std::pow(1000.f, (extraBand + 0.5f) / numExtraBands));
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayoutFromRegistry()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    // 호스트의 자동화와 저장된 프로젝트가 인덱스로 찾으므로 예전 순서를 유지
+    // (나중에 추가된 선형 위상, Mid/Side, 밴드 배치는 뒤에 옴)
+    addParameters(layout, 0, Parameter_LinearPhase);
+    addBandParameters(layout, 0, BandParameter_Placement);
+    addParameters(layout, Parameter_LinearPhase, numParameters);
+    addBandParameters(layout, BandParameter_Placement, numBandParameters);
+
+    return layout;
+}
+
+ParameterHandles::ParameterHandles(juce::AudioProcessorValueTreeState& apvts)
+{
+    for (size_t i = 0; i < (size_t) numParameters; ++i)
+    {
+        values[i] = apvts.getRawParameterValue(parameterSpecs[i].id);
+        parameters[i] = apvts.getParameter(parameterSpecs[i].id);
+        jassert(values[i] != nullptr && parameters[i] != nullptr);
+    }
+
+    for (int band = 0; band < numExtraBands; ++band)
+    {
+        for (int i = 0; i < numBandParameters; ++i)
+        {
+            auto& value = bandValues[(size_t) band][(size_t) i];
+            value = apvts.getRawParameterValue(getBandParameterID(band, static_cast<BandParameterIndex>(i)));
+            jassert(value != nullptr);
+        }
+    }
+}
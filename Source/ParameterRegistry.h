@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    ParameterRegistry.h
+    Created: 17 Oct 2026 11:41:06pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDFilterEngine.h"
+
+
+// 밴드 번호: 0 ~ 2 는 ChainPosition, 그 뒤로 추가 밴드 (Band 4 ~ Band 24)
+constexpr int numExtraBands = SIMDFilterEngine<float>::maxBands;
+constexpr int firstExtraBand = 3;
+constexpr int numBands = firstExtraBand + numExtraBands;
+
+// 파라미터 하나의 정의, 레이아웃과 에디터 연결과 오디오 스레드의 값 읽기가 모두 이 표에서 나옴
+// choices 가 있으면 선택 파라미터 (범위는 0 ~ numChoices - 1, 기본값은 인덱스)
+struct ParameterSpec
+{
+    const char* id;
+    float minimum, maximum, interval, skew, defaultValue;
+    const char* unit;
+    const char* const* choices;
+    int numChoices;
+
+    constexpr bool isChoice() const noexcept { return choices != nullptr; }
+};
+
+constexpr ParameterSpec makeFloatSpec(const char* id, float minimum, float maximum, float interval,
+                                      float skew, float defaultValue, const char* unit) noexcept
+{
+    return { id, minimum, maximum, interval, skew, defaultValue, unit, nullptr, 0 };
+}
+
+template <size_t NumChoices>
+constexpr ParameterSpec makeChoiceSpec(const char* id, const char* const (&choices)[NumChoices], int defaultIndex) noexcept
+{
+    return { id, 0.f, (float) (NumChoices - 1), 1.f, 1.f, (float) defaultIndex, "", choices, (int) NumChoices };
+}
+
+namespace ParameterChoices
+{
+    constexpr const char* slope[]               { "12", "24", "36", "48" };
+    constexpr const char* smoothing[]           { "Off", "16", "32", "64" };
+    constexpr const char* filterStructure[]     { "Biquad", "SVF" };
+    constexpr const char* oversampling[]        { "Off", "2x", "4x", "8x" };
+    constexpr const char* oversamplingQuality[] { "IIR", "FIR" };
+    constexpr const char* linearPhase[]         { "Off", "256", "1024", "4096" };
+    constexpr const char* stereoMode[]          { "Stereo", "Mid/Side" };
+    constexpr const char* placement[]           { "Stereo", "Mid", "Side" };
+    constexpr const char* bandType[]            { "Off", "Peak", "Low Shelf", "High Shelf", "Notch" };
+}
+
+// 밴드에 속하지 않는 파라미터, 표의 순서와 같아야 함
+enum ParameterIndex
+{
+    Parameter_LowCutFreq,
+    Parameter_HighCutFreq,
+    Parameter_PeakFreq,
+    Parameter_PeakGain,
+    Parameter_PeakQuality,
+    Parameter_LowCutSlope,
+    Parameter_HighCutSlope,
+    Parameter_Smoothing,
+    Parameter_FilterStructure,
+    Parameter_Oversampling,
+    Parameter_OversamplingQuality,
+    Parameter_LinearPhase,
+    Parameter_StereoMode,
+    Parameter_LowCutPlacement,
+    Parameter_PeakPlacement,
+    Parameter_HighCutPlacement,
+    numParameters
+};
+
+// 추가 밴드마다 있는 파라미터, ID 는 "Band N " 뒤에 표의 id 를 붙임
+enum BandParameterIndex
+{
+    BandParameter_Type,
+    BandParameter_Freq,
+    BandParameter_Gain,
+    BandParameter_Quality,
+    BandParameter_Placement,
+    numBandParameters
+};
+
+constexpr std::array<ParameterSpec, numParameters> parameterSpecs
+{{
+    makeFloatSpec("LowCut Freq", 20.f, 20000.f, 1.f, 0.6f, 20.f, "Hz"),
+    makeFloatSpec("HighCut Freq", 20.f, 20000.f, 1.f, 0.6f, 20000.f, "Hz"),
+    makeFloatSpec("Peak Freq", 20.f, 20000.f, 1.f, 0.3f, 1000.f, "Hz"),
+    makeFloatSpec("Peak Gain", -24.f, 24.f, 0.1f, 0.2f, 0.f, "db"),
+    makeFloatSpec("Peak Quality", 0.1f, 10.f, 0.01f, 0.3f, 1.f, ""),
+    makeChoiceSpec("LowCut Slope", ParameterChoices::slope, 0),
+    makeChoiceSpec("HighCut Slope", ParameterChoices::slope, 0),
+
+    // 자동화 스무딩, 켜면 선택한 샘플 간격마다 계수를 다시 설계하고 그 사이를 보간
+    makeChoiceSpec("Smoothing", ParameterChoices::smoothing, 0),
+
+    // 필터 구조, SVF 는 계수를 매 샘플 바꿔도 안정해서 빠른 자동화에 유리 (응답은 같음)
+    makeChoiceSpec("Filter Structure", ParameterChoices::filterStructure, 0),
+
+    // 나이퀴스트 근처에서 쌍선형 변환의 주파수 왜곡(cramping)을 줄이기 위한 오버샘플링
+    makeChoiceSpec("Oversampling", ParameterChoices::oversampling, 0),
+    makeChoiceSpec("Oversampling Quality", ParameterChoices::oversamplingQuality, 0),
+
+    // 선형 위상 모드, 숫자는 컨볼루션 분할 크기 (작을수록 지연이 짧고 CPU 를 더 씀)
+    makeChoiceSpec("Linear Phase", ParameterChoices::linearPhase, 0),
+
+    // Mid/Side 모드, 스테레오일 때만 적용 (선형 위상 모드에서는 쓰이지 않음)
+    makeChoiceSpec("Stereo Mode", ParameterChoices::stereoMode, 0),
+    makeChoiceSpec("LowCut Placement", ParameterChoices::placement, 0),
+    makeChoiceSpec("Peak Placement", ParameterChoices::placement, 0),
+    makeChoiceSpec("HighCut Placement", ParameterChoices::placement, 0)
+}};
+
+// 주파수 기본값은 밴드마다 다름 (getBandDefaultFreq), 여기 값은 쓰이지 않음
+constexpr std::array<ParameterSpec, numBandParameters> bandParameterSpecs
+{{
+    makeChoiceSpec("Type", ParameterChoices::bandType, 0),
+    makeFloatSpec("Freq", 20.f, 20000.f, 1.f, 0.3f, 1000.f, "Hz"),
+    makeFloatSpec("Gain", -24.f, 24.f, 0.1f, 0.2f, 0.f, "db"),
+    makeFloatSpec("Quality", 0.1f, 10.f, 0.01f, 0.3f, 1.f, ""),
+    makeChoiceSpec("Placement", ParameterChoices::placement, 0)
+}};
+
+namespace ParameterRegistryChecks
+{
+    constexpr bool isSameString(const char* a, const char* b) noexcept
+    {
+        while (*a != 0 && *a == *b)
+        {
+            ++a;
+            ++b;
+        }
+
+        return *a == *b;
+    }
+
+    template <size_t Size>
+    constexpr bool isValidTable(const std::array<ParameterSpec, Size>& specs) noexcept
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            const auto& spec = specs[i];
+
+            if (spec.minimum >= spec.maximum || spec.interval <= 0.f || spec.skew <= 0.f
+                || spec.defaultValue < spec.minimum || spec.defaultValue > spec.maximum)
+                return false;
+
+            for (size_t j = 0; j < i; ++j)
+                if (isSameString(spec.id, specs[j].id))
+                    return false;
+        }
+
+        return true;
+    }
+
+    static_assert(isValidTable(parameterSpecs), "parameter IDs must be unique and defaults inside their ranges");
+    static_assert(isValidTable(bandParameterSpecs), "band parameter IDs must be unique and defaults inside their ranges");
+}
+
+// "Band 4 Freq" 와 같은 추가 밴드의 파라미터 ID, 처음 한 번만 만들어 두고 재사용
+const juce::String& getBandParameterID(int extraBand, BandParameterIndex parameter);
+
+// 20 Hz ~ 20 kHz 사이에 로그 간격으로 펼친 기본 주파수
+float getBandDefaultFreq(int extraBand);
+
+// 표의 순서대로 파라미터를 만듦, 호스트가 보는 순서는 예전 레이아웃과 같음
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayoutFromRegistry();
+
+// 표의 모든 파라미터를 생성할 때 한 번만 찾아 둔 핸들
+// 이후 값 읽기는 배열 인덱스와 atomic load 뿐이므로 오디오 스레드에서 문자열을 쓰지 않음
+class ParameterHandles
+{
+public:
+    explicit ParameterHandles(juce::AudioProcessorValueTreeState& apvts);
+
+    float get(ParameterIndex parameter) const noexcept { return values[(size_t) parameter]->load(); }
+
+    float getBand(int extraBand, BandParameterIndex parameter) const noexcept
+    {
+        return bandValues[(size_t) extraBand][(size_t) parameter]->load();
+    }
+
+    juce::RangedAudioParameter& getParameter(ParameterIndex parameter) const noexcept { return *parameters[(size_t) parameter]; }
+
+private:
+    std::array<std::atomic<float>*, numParameters> values {};
+    std::array<std::array<std::atomic<float>*, numBandParameters>, numExtraBands> bandValues {};
+    std::array<juce::RangedAudioParameter*, numParameters> parameters {};
+
+    JUCE_DECLARE_NON_COPYABLE (ParameterHandles)
+};
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    PerformanceCounters.cpp
+    Created: 17 Oct 2026 9:41:15pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#include "PerformanceCounters.h"
+
+
+double PerformanceCounters::Snapshot::getPercentileNanoseconds(double percentile) const
+{
+    if (blocks == 0)
+        return 0.0;
+
+    const auto target = (juce::uint64) std::ceil(juce::jlimit(0.0, 1.0, percentile) * (double) blocks);
+    juce::uint64 count = 0;
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        count += nanosecondsHistogram[(size_t) bin];
+
+        if (count >= target)
+            return (double) getBinLowerEdge(bin, nanosecondsBase);
+    }
+
+    return (double) getBinLowerEdge(numBins - 1, nanosecondsBase);
+}
+
+void PerformanceCounters::recordBlock(int numSamples, juce::uint64 nanoseconds, juce::uint64 cycles,
+                                      juce::uint64 budgetNanoseconds, bool underflow) noexcept
+{
+    increment(nanosecondsHistogram[(size_t) getBin(nanoseconds, nanosecondsBase)], 1);
+
+    if (hasCycleCounter())
+        increment(cyclesHistogram[(size_t) getBin(cycles, cyclesBase)], 1);
+
+    increment(blocks, 1);
+    increment(samples, (juce::uint64) numSamples);
+    increment(totalNanoseconds, nanoseconds);
+
+    if (nanoseconds > maxNanoseconds.load(std::memory_order_relaxed))
+        maxNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+
+    // 블록 길이만큼의 실시간을 넘겼으면 그 블록 하나로도 드롭아웃이 날 수 있음
+    if (budgetNanoseconds > 0 && nanoseconds > budgetNanoseconds)
+        increment(overloads, 1);
+
+    if (underflow)
+        increment(denormalBlocks, 1);
+}
+
+PerformanceCounters::Snapshot PerformanceCounters::getSnapshot() const noexcept
+{
+    Snapshot snapshot;
+
+    for (size_t bin = 0; bin < (size_t) numBins; ++bin)
+    {
+        snapshot.nanosecondsHistogram[bin] = nanosecondsHistogram[bin].load(std::memory_order_relaxed);
+        snapshot.cyclesHistogram[bin] = cyclesHistogram[bin].load(std::memory_order_relaxed);
+    }
+
+    snapshot.blocks = blocks.load(std::memory_order_relaxed);
+    snapshot.samples = samples.load(std::memory_order_relaxed);
+    snapshot.totalNanoseconds = totalNanoseconds.load(std::memory_order_relaxed);
+    snapshot.maxNanoseconds = maxNanoseconds.load(std::memory_order_relaxed);
+    snapshot.redesigns = redesigns.load(std::memory_order_relaxed);
+    snapshot.bypassedSections = bypassedSections.load(std::memory_order_relaxed);
+    snapshot.denormalBlocks = denormalBlocks.load(std::memory_order_relaxed);
+    snapshot.overloads = overloads.load(std::memory_order_relaxed);
+    snapshot.activeSections = activeSections.load(std::memory_order_relaxed);
+    snapshot.hasCycleCounter = hasCycleCounter();
+
+    return snapshot;
+}
+
+juce::String PerformanceCounters::toJson(const Snapshot& snapshot, double sampleRate)
+{
+    // 구간은 [아래 끝, 개수] 쌍, 개수가 0 인 구간은 생략
+    auto makeHistogram = [](const std::array<juce::uint32, numBins>& histogram, juce::uint64 base)
+    {
+        juce::Array<juce::var> bins;
+
+        for (int bin = 0; bin < numBins; ++bin)
+            if (histogram[(size_t) bin] > 0)
+                bins.add(juce::Array<juce::var> { (juce::int64) getBinLowerEdge(bin, base),
+                                                  (juce::int64) histogram[(size_t) bin] });
+
+        return bins;
+    };
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("sampleRate", sampleRate);
+    root->setProperty("blocks", (juce::int64) snapshot.blocks);
+    root->setProperty("samples", (juce::int64) snapshot.samples);
+    root->setProperty("totalNanoseconds", (juce::int64) snapshot.totalNanoseconds);
+    root->setProperty("maxNanoseconds", (juce::int64) snapshot.maxNanoseconds);
+    root->setProperty("redesigns", (juce::int64) snapshot.redesigns);
+    root->setProperty("bypassedSections", (juce::int64) snapshot.bypassedSections);
+    root->setProperty("activeSections", snapshot.activeSections);
+    root->setProperty("denormalBlocks", (juce::int64) snapshot.denormalBlocks);
+    root->setProperty("overloads", (juce::int64) snapshot.overloads);
+    root->setProperty("nanosecondsHistogram", makeHistogram(snapshot.nanosecondsHistogram, nanosecondsBase));
+
+    if (snapshot.hasCycleCounter)
+        root->setProperty("cyclesHistogram", makeHistogram(snapshot.cyclesHistogram, cyclesBase));
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+//==============================================================================
+PerformanceExporter::PerformanceExporter(const PerformanceCounters& countersToUse,
+                                         std::function<double()> getSampleRateToUse,
+                                         const juce::File& directory)
+    : counters(countersToUse),
+      getSampleRate(std::move(getSampleRateToUse)),
+      file(directory.getChildFile("normalEQ-" + juce::Uuid().toDashedString() + ".json"))
+{
+    startTimer(1000);
+}
+
+PerformanceExporter::~PerformanceExporter()
+{
+    stopTimer();
+
+    // 세션이 끝날 때의 최종 값
+    timerCallback();
+}
+
+std::unique_ptr<PerformanceExporter> PerformanceExporter::createFromEnvironment(const PerformanceCounters& counters,
+                                                                                std::function<double()> getSampleRate)
+{
+    const auto path = juce::SystemStats::getEnvironmentVariable("NORMALEQ_PERF_DIR", {});
+
+    if (path.isEmpty() || ! juce::File::isAbsolutePath(path))
+        return nullptr;
+
+    const juce::File directory(path);
+
+    if (! directory.createDirectory())
+        return nullptr;
+
+    return std::make_unique<PerformanceExporter>(counters, std::move(getSampleRate), directory);
+}
+
+void PerformanceExporter::timerCallback()
+{
+    // 읽는 쪽이 쓰다 만 파일을 보지 않도록 임시 파일에 쓴 뒤 교체
+    juce::TemporaryFile temporary(file);
+
+    if (temporary.getFile().replaceWithText(PerformanceCounters::toJson(counters.getSnapshot(), getSampleRate())))
+        temporary.overwriteTargetFileWithTemporary();
+}
@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    PerformanceCounters.h
+    Created: 17 Oct 2026 9:41:15pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cfenv>
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+
+// processBlock 의 성능 계측, 인스턴스마다 하나
+// 오디오 스레드는 자기만 쓰는 atomic 에 relaxed 로 더하기만 하므로 기다리거나 할당하지 않음
+// 에디터와 내보내기 쪽은 getSnapshot 으로 언제든 읽을 수 있음 (항목 사이의 값은 약간 어긋날 수 있음)
+class PerformanceCounters
+{
+public:
+    // 1/4 옥타브 간격의 로그 구간, 구간 0 은 base 미만 전부, 마지막 구간은 그 이상 전부
+    static constexpr int numBins = 64;
+    static constexpr juce::uint64 nanosecondsBase = 256;     // 256 ns ~ 약 13 ms
+    static constexpr juce::uint64 cyclesBase = 1024;         // 1 k ~ 약 50 M 사이클
+
+    struct Snapshot
+    {
+        std::array<juce::uint32, numBins> nanosecondsHistogram {}, cyclesHistogram {};
+        juce::uint64 blocks = 0, samples = 0, totalNanoseconds = 0, maxNanoseconds = 0;
+        juce::uint64 redesigns = 0, bypassedSections = 0, denormalBlocks = 0, overloads = 0;
+        int activeSections = 0;
+        bool hasCycleCounter = false;
+
+        // 누적된 블록 시간 분포의 백분위 (구간의 아래 끝), 블록이 없으면 0
+        double getPercentileNanoseconds(double percentile) const;
+    };
+
+    PerformanceCounters() = default;
+
+    // 오디오 스레드 전용 ---------------------------------------------------------
+
+    // processBlock 전체를 감싸서 시간, 사이클, 언더플로(디노멀이 0 으로 밀린 경우)를 기록
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(PerformanceCounters& countersToUse, int numSamples, double sampleRate) noexcept
+            : counters(countersToUse),
+              budgetNanoseconds(sampleRate > 0.0 ? (juce::uint64) (1.0e9 * numSamples / sampleRate) : 0),
+              numBlockSamples(numSamples)
+        {
+            std::feclearexcept(FE_UNDERFLOW);
+            startCycles = readCycles();
+            startTicks = juce::Time::getHighResolutionTicks();
+        }
+
+        ~ScopedBlock()
+        {
+            const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+            const auto elapsedCycles = readCycles() - startCycles;
+            const auto underflow = std::fetestexcept(FE_UNDERFLOW) != 0;
+
+            counters.recordBlock(numBlockSamples, (juce::uint64) (elapsedTicks * counters.nanosecondsPerTick),
+                                 elapsedCycles, budgetNanoseconds, underflow);
+        }
+
+    private:
+        PerformanceCounters& counters;
+        juce::int64 startTicks = 0;
+        juce::uint64 startCycles = 0, budgetNanoseconds = 0;
+        int numBlockSamples = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBlock)
+    };
+
+    void addRedesign() noexcept                 { increment(redesigns, 1); }
+
+    // 블록마다 현재 엔진의 활성 섹션 수를 기록, 빠진 섹션 수가 누적됨
+    void setActiveSections(int numActive, int maxSections) noexcept
+    {
+        activeSections.store(numActive, std::memory_order_relaxed);
+        increment(bypassedSections, (juce::uint64) juce::jmax(0, maxSections - numActive));
+    }
+
+    // 어느 스레드에서든 -----------------------------------------------------------
+
+    Snapshot getSnapshot() const noexcept;
+
+    // 모니터링이 읽어 갈 수 있는 JSON (히스토그램 구간의 경계 포함)
+    static juce::String toJson(const Snapshot& snapshot, double sampleRate);
+
+    static constexpr bool hasCycleCounter() noexcept
+    {
+       #if JUCE_INTEL
+        return true;
+       #else
+        return false;
+       #endif
+    }
+
+    // 구간 bin 의 아래 끝 값
+    static juce::uint64 getBinLowerEdge(int bin, juce::uint64 base) noexcept
+    {
+        if (bin <= 0)
+            return 0;
+
+        const auto index = bin - 1;
+        return (base * (juce::uint64) (4 + index % 4) / 4) << (index / 4);
+    }
+
+    // base 는 4 이상의 2 의 거듭제곱
+    static int getBin(juce::uint64 value, juce::uint64 base) noexcept
+    {
+        if (value < base)
+            return 0;
+
+        const auto highestBit = getHighestBit(value);
+        const auto octave = highestBit - getHighestBit(base);
+        const auto fraction = (int) ((value >> (highestBit - 2)) & 3);
+
+        return juce::jmin(numBins - 1, 1 + octave * 4 + fraction);
+    }
+
+private:
+    using Counter = std::atomic<juce::uint64>;
+    using Histogram = std::array<std::atomic<juce::uint32>, numBins>;
+
+    // 쓰는 스레드가 하나뿐이므로 read-modify-write 대신 load + store
+    template <typename Type>
+    static void increment(std::atomic<Type>& counter, typename std::atomic<Type>::value_type amount) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static int getHighestBit(juce::uint64 value) noexcept
+    {
+        return (value >> 32) != 0 ? 32 + juce::findHighestSetBit((juce::uint32) (value >> 32))
+                                  : juce::findHighestSetBit((juce::uint32) value);
+    }
+
+    // x86 의 타임스탬프 카운터 (기준 클럭 사이클), 그 밖의 CPU 에서는 0
+    static juce::uint64 readCycles() noexcept
+    {
+       #if JUCE_INTEL
+        return (juce::uint64) __rdtsc();
+       #else
+        return 0;
+       #endif
+    }
+
+    void recordBlock(int numSamples, juce::uint64 nanoseconds, juce::uint64 cycles,
+                     juce::uint64 budgetNanoseconds, bool underflow) noexcept;
+
+    const double nanosecondsPerTick = 1.0e9 / (double) juce::Time::getHighResolutionTicksPerSecond();
+
+    Histogram nanosecondsHistogram {}, cyclesHistogram {};
+    Counter blocks { 0 }, samples { 0 }, totalNanoseconds { 0 }, maxNanoseconds { 0 };
+    Counter redesigns { 0 }, bypassedSections { 0 }, denormalBlocks { 0 }, overloads { 0 };
+    std::atomic<int> activeSections { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (PerformanceCounters)
+};
+
+// 환경 변수 NORMALEQ_PERF_DIR 이 설정되어 있으면 그 폴더에 인스턴스마다 JSON 파일을 주기적으로 덮어씀
+// 메시지 스레드의 타이머에서 쓰므로 오디오 스레드에는 영향이 없음
+class PerformanceExporter : private juce::Timer
+{
+public:
+    PerformanceExporter(const PerformanceCounters& countersToUse, std::function<double()> getSampleRateToUse,
+                        const juce::File& directory);
+    ~PerformanceExporter() override;
+
+    // 환경 변수가 없으면 nullptr
+    static std::unique_ptr<PerformanceExporter> createFromEnvironment(const PerformanceCounters& counters,
+                                                                      std::function<double()> getSampleRate);
+
+private:
+    void timerCallback() override;
+
+    const PerformanceCounters& counters;
+    std::function<double()> getSampleRate;
+    juce::File file;
+
+    JUCE_DECLARE_NON_COPYABLE (PerformanceExporter)
+};
@@ -12,22 +12,14 @@
 
 DrawResponseCurve::DrawResponseCurve(NormalEQAudioProcessor& p) : audioProcessor(p)
 {
-    const auto& params = audioProcessor.getParameters();
-    for (auto param : params)
-    {
-        param->addListener(this);
-    }
     updateChain();
-    startTimerHz(60);
+    audioProcessor.getSpectrumAnalyzer().addViewer();
+    startTimerHz(idleRefreshRate);
 }
 
 DrawResponseCurve::~DrawResponseCurve()
 {
-    const auto& params = audioProcessor.getParameters();
-    for (auto param : params)
-    {
-        param->removeListener(this);
-    }
+    audioProcessor.getSpectrumAnalyzer().removeViewer();
 }
 
 void DrawResponseCurve::paint(juce::Graphics& g)
@@ -35,116 +27,112 @@ void DrawResponseCurve::paint(juce::Graphics& g)
     auto responseArea = getAnalysisArea();
     auto responseWidth = responseArea.getWidth();
     
+    // 격자와 눈금은 크기나 화면 배율이 바뀔 때만 이미지로 다시 그림
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    
+    if (! background.isValid() || scale != backgroundScale)
+        renderBackground(scale);
  
     g.drawImage(background, responseArea.toFloat());
     g.setColour(customColour.almond);
     g.drawRect(responseArea);
+    
+    // 스펙트럼은 분석 영역에 맞춰 늘려서 그리기만 함
+    const auto spectrumTransform = juce::AffineTransform::scale((float) responseArea.getWidth(), (float) responseArea.getHeight())
+                                                         .translated((float) responseArea.getX(), (float) responseArea.getY());
+    
+    g.setColour(customColour.almondAlpha);
+    g.strokePath(preSpectrumPath, juce::PathStrokeType(1.f), spectrumTransform);
+    g.setColour(customColour.zest.withAlpha(0.7f));
+    g.strokePath(postSpectrumPath, juce::PathStrokeType(1.f), spectrumTransform);
 
-    auto& lowCut = monoChain.get<ChainPosition::LowCut>();
-    auto& peak = monoChain.get<ChainPosition::Peak>();
-    auto& highCut = monoChain.get<ChainPosition::HighCut>();
-
-    auto sampleRate = audioProcessor.getSampleRate();
-
-    // 저장할 공간이 필요(double)
-    std::vector<double> mags;
-
-    mags.resize(responseWidth);
-
-    for (int i = 0; i < responseWidth; ++i)
-    {
-        // 픽셀을 따라 반복하면서 주파수 진폭(Magnitude)을 계산
-        // magnitude는 데시벨과 다르게 곱의 연산을 하므로 시작값 1을 주어야 함
-        double mag = 1.f;
-
-        // mapToLog10을 통해 픽셀 공간에 주파수를 매핑할 수 있다.
-        auto freq = juce::mapToLog10(double(i) / double(responseWidth), 20.0, 20000.0);
-        if (!monoChain.isBypassed<ChainPosition::Peak>())
-            mag *= peak.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-
-        if (!lowCut.isBypassed<0>())
-            mag *= lowCut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!lowCut.isBypassed<1>())
-            mag *= lowCut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!lowCut.isBypassed<2>())
-            mag *= lowCut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!lowCut.isBypassed<3>())
-            mag *= lowCut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-
-        if (!highCut.isBypassed<0>())
-            mag *= highCut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!highCut.isBypassed<1>())
-            mag *= highCut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!highCut.isBypassed<2>())
-            mag *= highCut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!highCut.isBypassed<3>())
-            mag *= highCut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-
-        mags[i] = juce::Decibels::gainToDecibels(mag);
-    }
-
-    juce::Path responseCurve;
-
-    const double outputMin = responseArea.getBottom();
-    const double outputMax = responseArea.getY();
-
-    auto map = [outputMin, outputMax](double input)
-    {
-        // window에 -24~24 범위의 데시벨 높이를 가지도록
-        return juce::jmap(input, -24.0, 24.0, outputMin, outputMax);
-    };
-
-    // getX()->leftedge에서 시작, mags.front의 값 => 시작점
-    responseCurve.startNewSubPath(responseArea.getX(), map(mags.front()));
-
-    for (size_t i = 1; i < mags.size(); ++i)
-    {
-        responseCurve.lineTo(responseArea.getX() + i, map(mags[i]));
-    }
+    // 계수나 크기가 바뀌었을 때만 다시 계산되고, 그 외에는 캐시된 경로를 그대로 그림
+    // HiDPI 화면에서도 물리 픽셀마다 점 하나가 되도록 배율을 곱함
+    const auto numPoints = juce::roundToInt((float) responseWidth * scale);
+    
+    // window에 -24~24 범위의 데시벨 높이를 가지도록
+    const auto& responseCurve = responseCurvePath.getPath(responseArea.toFloat(), numPoints, -24.f, 24.f);
 
     g.setColour(customColour.almond);
     g.strokePath(responseCurve, juce::PathStrokeType(2.1f));
 }
 
-void DrawResponseCurve::parameterValueChanged(int parameterIndex, float newValue)
-{
-    // 파라미터가 변경되었을 때 atomic을 true로 바꿔줌
-    parameterChanged.set(true);
-}
-
 void DrawResponseCurve::timerCallback()
 {
-    // true일 경우 다시 false로 바꾸기
-    if (parameterChanged.compareAndSetBool(false, true))
+    auto changed = false;
+    
+    // 파라미터나 샘플 레이트가 바뀌면 설계 스레드가 새 버전을 발행함
+    if (updateChain())
     {
-        // monochain 업데이트
-        updateChain();
-        // 타이머 업데이트가 필요함
         // repaint를 통해 reponse curve 업데이트
         repaint();
+        changed = true;
+    }
+    
+    // 새 스펙트럼이 발행되었을 때만 경로를 받아 다시 그림
+    auto& analyzer = audioProcessor.getSpectrumAnalyzer();
+    const auto newVersion = analyzer.getVersion();
+    
+    if (newVersion != analyzerVersion)
+    {
+        analyzerVersion = newVersion;
+        analyzer.getPath(SpectrumAnalyzer::preEQ, preSpectrumPath);
+        analyzer.getPath(SpectrumAnalyzer::postEQ, postSpectrumPath);
+        repaint(getAnalysisArea());
+        changed = true;
+    }
+    
+    // 무언가 움직이는 동안에는 화면 주사율로, 한동안 변화가 없으면 낮은 주기로 플래그만 확인
+    if (changed)
+    {
+        idleTicks = 0;
+        
+        if (! refreshingFast)
+        {
+            refreshingFast = true;
+            startTimerHz(activeRefreshRate);
+        }
+    }
+    else if (refreshingFast && ++idleTicks >= idleTicksBeforeSlowDown)
+    {
+        refreshingFast = false;
+        startTimerHz(idleRefreshRate);
     }
 }
 
-void DrawResponseCurve::updateChain()
+bool DrawResponseCurve::updateChain()
 {
-    auto chainSettings = getChainSettings(audioProcessor.apvts);
-    auto peakCoefficients = makePeakFilter(chainSettings, audioProcessor.getSampleRate());
-    updateCoefficients(monoChain.get<ChainPosition::Peak>().coefficients, peakCoefficients);
+    const auto& snapshot = audioProcessor.getEditorSnapshot();
     
+    if (snapshot.version == snapshotVersion)
+        return false;
     
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, audioProcessor.getSampleRate());
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, audioProcessor.getSampleRate());
-    updateCutFilter(monoChain.get<ChainPosition::LowCut>(), lowCutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(monoChain.get<ChainPosition::HighCut>(), highCutCoefficients, chainSettings.highCutSlope);
+    snapshotVersion = snapshot.version;
+    
+    // 오디오 스레드가 처리하는 것과 같은 계수, 설계 샘플 레이트(오버샘플링 포함)로 응답을 계산
+    std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxSections> sections;
+    const auto numSections = snapshot.getActiveSections(sections);
+    responseCurvePath.setSections(sections.data(), numSections, snapshot.sampleRate);
+    
+    return true;
 }
 
 void DrawResponseCurve::resized()
 {
-    background = juce::Image(juce::Image::PixelFormat::RGB, getWidth(),getHeight(),true);
-    
- 
+    // 격자는 다음 paint 에서 그때의 화면 배율로 다시 그림
+    background = juce::Image();
+}
+
+void DrawResponseCurve::renderBackground(float scale)
+{
+    backgroundScale = scale;
+    background = juce::Image(juce::Image::PixelFormat::RGB,
+                             juce::jmax(1, juce::roundToInt((float) getWidth() * scale)),
+                             juce::jmax(1, juce::roundToInt((float) getHeight() * scale)),
+                             true);
 
     juce::Graphics g(background);
+    g.addTransform(juce::AffineTransform::scale(scale));
     
     
     juce::Array<float> freqs
@@ -261,6 +249,69 @@ juce::Rectangle<int> DrawResponseCurve::getAnalysisArea()
 }
 
 
+//==============================================================================
+
+PerformanceOverlay::PerformanceOverlay(NormalEQAudioProcessor& p) : audioProcessor(p)
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+void PerformanceOverlay::visibilityChanged()
+{
+    if (isVisible())
+    {
+        timerCallback();
+        startTimerHz(4);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void PerformanceOverlay::timerCallback()
+{
+    const auto snapshot = audioProcessor.getPerformanceCounters().getSnapshot();
+    const auto sampleRate = audioProcessor.getSampleRate();
+    
+    // 처리 시간이 실제 오디오 시간에서 차지하는 비율
+    const auto audioSeconds = sampleRate > 0.0 ? (double) snapshot.samples / sampleRate : 0.0;
+    const auto load = audioSeconds > 0.0 ? (double) snapshot.totalNanoseconds * 1.0e-9 / audioSeconds : 0.0;
+    
+    auto toMicroseconds = [](double nanoseconds) { return juce::String(nanoseconds * 1.0e-3, 1); };
+    
+    lines.clearQuick();
+    lines.add("block p50 " + toMicroseconds(snapshot.getPercentileNanoseconds(0.5))
+              + " / p99 " + toMicroseconds(snapshot.getPercentileNanoseconds(0.99))
+              + " / max " + toMicroseconds((double) snapshot.maxNanoseconds) + " us");
+    lines.add("load " + juce::String(load * 100.0, 2) + " %,  overloads " + juce::String((juce::int64) snapshot.overloads));
+    lines.add("redesigns " + juce::String((juce::int64) snapshot.redesigns));
+    lines.add("active sections " + juce::String(snapshot.activeSections)
+              + ",  bypassed " + juce::String((juce::int64) snapshot.bypassedSections));
+    lines.add("denormal blocks " + juce::String((juce::int64) snapshot.denormalBlocks)
+              + " / " + juce::String((juce::int64) snapshot.blocks));
+    
+    repaint();
+}
+
+void PerformanceOverlay::paint(juce::Graphics& g)
+{
+    g.setColour(customColour.background.withAlpha(0.85f));
+    g.fillRect(getLocalBounds());
+    g.setColour(customColour.almondAlpha);
+    g.drawRect(getLocalBounds());
+    
+    g.setColour(customColour.almond);
+    g.setFont(11.f);
+    
+    auto area = getLocalBounds().reduced(6, 4);
+    const auto lineHeight = area.getHeight() / juce::jmax(1, lines.size());
+    
+    for (const auto& line : lines)
+        g.drawFittedText(line, area.removeFromTop(lineHeight), juce::Justification::centredLeft, 1);
+}
+
+
 //==============================================================================
 
 CustomDialLookAndFeel::CustomDialLookAndFeel() {}
@@ -363,25 +414,30 @@ NormalEQAudioProcessorEditor::NormalEQAudioProcessorEditor(NormalEQAudioProcesso
     : AudioProcessorEditor(&p), audioProcessor(p),
 
     
-    highCutFreqBox(*audioProcessor.apvts.getParameter("HighCut Freq"), "Hz"),
-    peakFreqBox(*audioProcessor.apvts.getParameter("Peak Freq"), "Hz"),
-    peakGainBox(*audioProcessor.apvts.getParameter("Peak Gain"), "db"),
-    peakQualityBox(*audioProcessor.apvts.getParameter("Peak Quality"), ""),
-    lowCutFreqBox(*audioProcessor.apvts.getParameter("LowCut Freq"), "Hz"),
+    // 파라미터와 단위, ID 는 모두 ParameterRegistry.h 의 표에서 가져옴
+    highCutFreqBox(audioProcessor.getParameterHandles().getParameter(Parameter_HighCutFreq), parameterSpecs[Parameter_HighCutFreq].unit),
+    peakFreqBox(audioProcessor.getParameterHandles().getParameter(Parameter_PeakFreq), parameterSpecs[Parameter_PeakFreq].unit),
+    peakGainBox(audioProcessor.getParameterHandles().getParameter(Parameter_PeakGain), parameterSpecs[Parameter_PeakGain].unit),
+    peakQualityBox(audioProcessor.getParameterHandles().getParameter(Parameter_PeakQuality), parameterSpecs[Parameter_PeakQuality].unit),
+    lowCutFreqBox(audioProcessor.getParameterHandles().getParameter(Parameter_LowCutFreq), parameterSpecs[Parameter_LowCutFreq].unit),
 
     drawResponseCurveComponent(audioProcessor),
-    highCutFreqBoxAttatchment(audioProcessor.apvts, "HighCut Freq", highCutFreqBox),
-    peakFreqBoxAttatchment(audioProcessor.apvts, "Peak Freq", peakFreqBox),
-    peakGainBoxAttatchment(audioProcessor.apvts, "Peak Gain", peakGainBox),
-    peakQualityBoxAttatchment(audioProcessor.apvts, "Peak Quality", peakQualityBox),
-    lowCutFreqBoxAttatchment(audioProcessor.apvts, "LowCut Freq", lowCutFreqBox),
-
-    highCutSlopeSliderAttatchment(audioProcessor.apvts, "HighCut Slope", highCutSlopeSlider),
-    lowCutSlopeSliderAttatchment(audioProcessor.apvts, "LowCut Slope", lowCutSlopeSlider)
+    performanceOverlay(audioProcessor),
+    highCutFreqBoxAttatchment(audioProcessor.apvts, parameterSpecs[Parameter_HighCutFreq].id, highCutFreqBox),
+    peakFreqBoxAttatchment(audioProcessor.apvts, parameterSpecs[Parameter_PeakFreq].id, peakFreqBox),
+    peakGainBoxAttatchment(audioProcessor.apvts, parameterSpecs[Parameter_PeakGain].id, peakGainBox),
+    peakQualityBoxAttatchment(audioProcessor.apvts, parameterSpecs[Parameter_PeakQuality].id, peakQualityBox),
+    lowCutFreqBoxAttatchment(audioProcessor.apvts, parameterSpecs[Parameter_LowCutFreq].id, lowCutFreqBox),
+
+    highCutSlopeSliderAttatchment(audioProcessor.apvts, parameterSpecs[Parameter_HighCutSlope].id, highCutSlopeSlider),
+    lowCutSlopeSliderAttatchment(audioProcessor.apvts, parameterSpecs[Parameter_LowCutSlope].id, lowCutSlopeSlider)
 {
     setSize(650, 650);
     setWantsKeyboardFocus(true);
     
+    // 배경 이미지가 전체를 덮으므로 뒤의 호스트 창은 다시 그리지 않아도 됨
+    setOpaque(true);
+    
     for ( auto comp : getComps() )
     {
         addAndMakeVisible(comp);
@@ -389,19 +445,41 @@ NormalEQAudioProcessorEditor::NormalEQAudioProcessorEditor(NormalEQAudioProcesso
         comp->setColour(juce::Slider::textBoxOutlineColourId, customColour.almond); 
     }
     
-    juce::LookAndFeel::setDefaultLookAndFeel(&customLookAndFeel);
+    // 여러 에디터가 같은 룩앤필을 지정하므로 해제는 SharedEditorResources 가 마지막에 함
+    juce::LookAndFeel::setDefaultLookAndFeel(&sharedResources->getLookAndFeel());
 
-    
+    // 응답 곡선 위에 겹쳐 그림, 처음에는 숨겨 둠
+    addChildComponent(performanceOverlay);
 }
 
 NormalEQAudioProcessorEditor::~NormalEQAudioProcessorEditor()
 {
-    juce::LookAndFeel::setDefaultLookAndFeel(nullptr);
 }
 
 //==============================================================================
 void NormalEQAudioProcessorEditor::paint(juce::Graphics& g)
 {
+    // 배경, 구분선, 아이콘은 변하지 않으므로 이미지로 한 번만 그려 두고 복사만 함
+    // 응답 곡선이 다시 그려질 때마다 이 함수도 불리므로 SVG 를 매번 그리지 않도록
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    
+    if (! staticLayer.isValid() || scale != staticLayerScale)
+        renderStaticLayer(scale);
+    
+    g.drawImage(staticLayer, getLocalBounds().toFloat());
+}
+
+void NormalEQAudioProcessorEditor::renderStaticLayer(float scale)
+{
+    staticLayerScale = scale;
+    staticLayer = juce::Image(juce::Image::RGB,
+                              juce::jmax(1, juce::roundToInt((float) getWidth() * scale)),
+                              juce::jmax(1, juce::roundToInt((float) getHeight() * scale)),
+                              false);
+    
+    juce::Graphics g(staticLayer);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll(customColour.background);
@@ -418,21 +496,17 @@ void NormalEQAudioProcessorEditor::paint(juce::Graphics& g)
     float getWidth = juce::Component::getWidth();
     float getHeight = juce::Component::getHeight();
 
-    //g.drawImage(drawImage.catImage, 0, 0, 50, 50, 0, 0, drawImage.catImage.getWidth(), drawImage.catImage.getHeight());
-    //g.drawImage(drawImage.lowCutImage, getWidth * 0.2 - 12, getHeight * 0.38, 24, 20, 0, 0, drawImage.lowCutImage.getWidth(),drawImage.lowCutImage.getHeight());
-    //g.drawImage(drawImage.peakImage, getWidth * 0.5 - 12, getHeight * 0.38, 24, 20, 0, 0, drawImage.peakImage.getWidth(),drawImage.peakImage.getHeight());
-    //g.drawImage(drawImage.highCutImage, getWidth * 0.8 - 12, getHeight * 0.38, 24, 20, 0, 0, drawImage.highCutImage.getWidth(),drawImage.highCutImage.getHeight());
-
     g.setColour(customColour.almond);
 
-    drawImage.lowCut->setTransformToFit(juce::Rectangle<float>(getWidth * 0.2 - 12, getHeight * 0.38, 20, 20), juce::RectanglePlacement::centred);
-    drawImage.lowCut ->draw(g, 1.f);
+    // 아이콘은 공유되므로 변환을 바꾸지 않는 drawWithin 으로 그림
+    sharedResources->getIcon(SharedEditorResources::Icon_LowCut)
+        .drawWithin(g, juce::Rectangle<float>(getWidth * 0.2 - 12, getHeight * 0.38, 20, 20), juce::RectanglePlacement::centred, 1.f);
 
-    drawImage.peak->setTransformToFit(juce::Rectangle<float>(getWidth * 0.5 - 12, getHeight * 0.38, 20, 20), juce::RectanglePlacement::centred);
-    drawImage.peak->draw(g, 1.f);
+    sharedResources->getIcon(SharedEditorResources::Icon_Peak)
+        .drawWithin(g, juce::Rectangle<float>(getWidth * 0.5 - 12, getHeight * 0.38, 20, 20), juce::RectanglePlacement::centred, 1.f);
 
-    drawImage.highCut->setTransformToFit(juce::Rectangle<float>(getWidth * 0.8 - 12, getHeight * 0.38, 20, 20), juce::RectanglePlacement::centred);
-    drawImage.highCut->draw(g, 1.f);
+    sharedResources->getIcon(SharedEditorResources::Icon_HighCut)
+        .drawWithin(g, juce::Rectangle<float>(getWidth * 0.8 - 12, getHeight * 0.38, 20, 20), juce::RectanglePlacement::centred, 1.f);
 
     
 } 
@@ -442,6 +516,8 @@ void NormalEQAudioProcessorEditor::resized()
     // This is generally where you'll want to lay out the positions of any
     // subcomponents in your editor..
 
+    staticLayer = juce::Image();
+
     float getHeight = juce::Component::getHeight() / 3 * 2 + 10;
     float getWidth = juce::Component::getWidth() / 3 - 70;
 
@@ -456,12 +532,25 @@ void NormalEQAudioProcessorEditor::resized()
     lowCutSlopeSlider.setBounds(getWidth * 0.5, getHeight * 0.98, 50, 50);
     highCutSlopeSlider.setBounds(getWidth * 3.5 + 25, getHeight * 0.98, 50, 50);
     drawResponseCurveComponent.setBounds(responseArea);
+    performanceOverlay.setBounds(responseArea.removeFromRight(230).removeFromTop(130).reduced(8));
    
 
     
 }
 
 
+bool NormalEQAudioProcessorEditor::keyPressed(const juce::KeyPress& key)
+{
+    if (key.getTextCharacter() == 'p' || key.getTextCharacter() == 'P')
+    {
+        performanceOverlay.setVisible(! performanceOverlay.isVisible());
+        return true;
+    }
+    
+    return false;
+}
+
+
 std::vector<juce::Component*> NormalEQAudioProcessorEditor::getComps()
 {
     return
@@ -11,6 +11,7 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "AbletonStyleBox.h"
+#include "ResponseCurve.h"
 
 
 struct CustomColour
@@ -22,34 +23,67 @@ struct CustomColour
     const juce::Colour mahogany     = juce::Colour::fromRGB(97, 8, 7);
 };
 
+// 응답 곡선은 프로세서의 설계 스레드가 발행한 스냅샷으로 그림 (에디터에서는 설계하지 않음)
+// 스냅샷의 버전이 바뀌었을 때만 섹션을 다시 받음
 struct DrawResponseCurve : juce::Component,
-                           juce::AudioProcessorParameter::Listener,
                            juce::Timer
 {
     DrawResponseCurve(NormalEQAudioProcessor& p);
     ~DrawResponseCurve();
 
-    void parameterValueChanged(int parameterIndex, float newValue) override;
-    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override { }
     void timerCallback() override;
     
     void paint(juce::Graphics& g) override;
     void resized() override;
-    void updateChain();
+    
+    // 새 스냅샷이 있으면 섹션을 받고 true
+    bool updateChain();
 
 private:
     NormalEQAudioProcessor& audioProcessor;
     CustomColour customColour;
-    juce::Atomic<bool> parameterChanged{ false };
-    MonoChain  monoChain;
+    ResponseCurve responseCurvePath;
+    juce::uint32 snapshotVersion = 0;
     
+    // 격자와 눈금, 물리 픽셀 해상도로 그려 둠
     juce::Image background;
+    float backgroundScale = 0.f;
+    void renderBackground(float scale);
+    
+    // 변화가 없을 때는 낮은 주기로 확인만 하고, 변화가 있으면 화면 주사율로 올림
+    static constexpr int idleRefreshRate = 5;
+    static constexpr int activeRefreshRate = 60;
+    static constexpr int idleTicksBeforeSlowDown = 30;
+    bool refreshingFast = false;
+    int idleTicks = 0;
+    
+    // 분석 스레드가 만든 정규화된 경로의 복사본, 버전이 바뀌었을 때만 다시 받음
+    juce::Path preSpectrumPath, postSpectrumPath;
+    juce::uint32 analyzerVersion = 0;
     
     juce::Rectangle<int> getRenderArea();
     juce::Rectangle<int> getAnalysisArea();
 };
 
 
+// 프로세서의 성능 카운터를 보여주는 작은 오버레이, 에디터에서 P 키로 켜고 끔
+// 보일 때만 초당 4 번 스냅샷을 읽음
+struct PerformanceOverlay : juce::Component,
+                            juce::Timer
+{
+    PerformanceOverlay(NormalEQAudioProcessor& p);
+
+    void paint(juce::Graphics& g) override;
+    void visibilityChanged() override;
+    void timerCallback() override;
+
+private:
+    NormalEQAudioProcessor& audioProcessor;
+    CustomColour customColour;
+    juce::StringArray lines;
+};
+
+
 struct CustomDialLookAndFeel : public juce::LookAndFeel_V4
 {
     CustomDialLookAndFeel();
@@ -78,15 +112,6 @@ private:
 };
 
 
-struct DrawImage : public juce::Component
-{
-    
-    const std::unique_ptr<juce::Drawable> lowCut = juce::Drawable::createFromImageData(BinaryData::highpass_svg, BinaryData::highpass_svgSize);
-    const std::unique_ptr<juce::Drawable> peak = juce::Drawable::createFromImageData(BinaryData::bell_svg, BinaryData::bell_svgSize);
-    const std::unique_ptr<juce::Drawable> highCut = juce::Drawable::createFromImageData(BinaryData::lowpass_svg, BinaryData::lowpass_svgSize);
-    
-};
-
 //==============================================================================
 /**
 */
@@ -105,14 +130,16 @@ public:
     //==============================================================================
     void paint (juce::Graphics&) override;
     void resized() override;
+    bool keyPressed (const juce::KeyPress& key) override;
         
 private:
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     NormalEQAudioProcessor& audioProcessor;
     CustomColour customColour;
-    DrawImage drawImage;
-    CustomLookAndFeel customLookAndFeel;
+    
+    // 폰트, 룩앤필, 아이콘은 모든 인스턴스의 에디터가 함께 씀, 상자들보다 먼저 만들어지고 나중에 해제되도록 앞에 둠
+    juce::SharedResourcePointer<SharedEditorResources> sharedResources;
     
     AbletonStyleBox highCutFreqBox,
                     peakFreqBox,
@@ -124,6 +151,12 @@ private:
                        lowCutSlopeSlider;
     
     DrawResponseCurve drawResponseCurveComponent;
+    PerformanceOverlay performanceOverlay;
+    
+    // 배경, 구분선, 아이콘을 그려 둔 이미지, 크기나 화면 배율이 바뀔 때만 다시 그림
+    juce::Image staticLayer;
+    float staticLayerScale = 0.f;
+    void renderStaticLayer(float scale);
     
     using APVTS = juce::AudioProcessorValueTreeState;
     using Attatchment = APVTS::SliderAttachment;
@@ -11,6 +11,11 @@
 
 //==============================================================================
 NormalEQAudioProcessor::NormalEQAudioProcessor()
+    : NormalEQAudioProcessor(true)
+{
+}
+
+NormalEQAudioProcessor::NormalEQAudioProcessor(bool shouldLoadUserPresetLibrary)
 #ifndef JucePlugin_PreferredChannelConfigurations
      : AudioProcessor (BusesProperties()
                      #if ! JucePlugin_IsMidiEffect
@@ -22,10 +27,79 @@ NormalEQAudioProcessor::NormalEQAudioProcessor()
                        )
 #endif
 {
+    for (auto* param : getParameters())
+    {
+        auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param);
+        jassert(paramWithID != nullptr);
+        
+        parameterBands.push_back(getBandIndex(paramWithID->paramID));
+        param->addListener(this);
+        
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param))
+            parametersByKey.push_back({ getParameterKey(paramWithID->paramID), ranged });
+    }
+    
+    std::sort(parametersByKey.begin(), parametersByKey.end(),
+              [](const auto& a, const auto& b) { return a.key < b.key; });
+    
+    // 두 ID 의 키가 같으면 저장된 상태가 섞이므로 ID 를 바꿔야 함
+    jassert(std::adjacent_find(parametersByKey.begin(), parametersByKey.end(),
+                               [](const auto& a, const auto& b) { return a.key == b.key; }) == parametersByKey.end());
+    
+    // 선형 위상 모드가 켜져 있을 때만 설계 스레드에서 커널을 다시 만듦
+    // Mid/Side 에서는 Placement 에 따라 Mid 와 Side 커널을 따로 만듦 (IIR 경로처럼 2채널일 때만)
+    coefficientDesigner.onSnapshotDesigned = [this](const CoefficientSnapshot& snapshot)
+    {
+        if (parameterHandles.get(Parameter_LinearPhase) < 0.5f)
+            return;
+        
+        using Engine = SIMDFilterEngine<double>;
+        std::array<BiquadCoefficients<double>, Engine::maxSections> sections;
+        
+        if (snapshot.midSide && getTotalNumOutputChannels() == 2)
+        {
+            std::array<BiquadCoefficients<double>, Engine::maxSections> sideSections;
+            const auto numMidSections = snapshot.getActiveSections(sections, Engine::midLane);
+            const auto numSideSections = snapshot.getActiveSections(sideSections, Engine::sideLane);
+            linearPhaseEQ.updateKernel(sections.data(), numMidSections, sideSections.data(), numSideSections, snapshot.sampleRate);
+            return;
+        }
+        
+        const auto numSections = snapshot.getActiveSections(sections);
+        linearPhaseEQ.updateKernel(sections.data(), numSections, snapshot.sampleRate);
+    };
+    
+    performanceExporter = PerformanceExporter::createFromEnvironment(performanceCounters, [this] { return getSampleRate(); });
+    
+    // 기본 MIDI CC 배정 (정의되지 않은 컨트롤러 번호 14 ~ 18)
+    const std::pair<int, ParameterIndex> defaultMidiControllers[] =
+    {
+        { 14, Parameter_LowCutFreq },
+        { 15, Parameter_HighCutFreq },
+        { 16, Parameter_PeakFreq },
+        { 17, Parameter_PeakGain },
+        { 18, Parameter_PeakQuality }
+    };
+    
+    for (const auto& [controller, parameter] : defaultMidiControllers)
+        midiControllerParameters[(size_t) controller] = parameter;
+    
+    if (shouldLoadUserPresetLibrary && getDefaultPresetLibraryFile().existsAsFile())
+        loadPresetLibrary(getDefaultPresetLibraryFile());
+    
+    markAllBandsChanged();
+    
+    startTimerHz(messageThreadPollHz);
 }
 
 NormalEQAudioProcessor::~NormalEQAudioProcessor()
 {
+    stopTimer();
+    
+    for (auto* param : getParameters())
+    {
+        param->removeListener(this);
+    }
 }
 
 //==============================================================================
@@ -63,27 +137,43 @@ bool NormalEQAudioProcessor::isMidiEffect() const
 
 double NormalEQAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // 오버샘플링 필터 또는 선형 위상 커널의 길이 (지연의 두 배 정도)
+    const auto sampleRate = getSampleRate();
+    
+    if (sampleRate <= 0.0)
+        return 0.0;
+    
+    // 호스트에 보고된 값은 메시지 스레드의 타이머를 거치므로 늦을 수 있음
+    // 오디오 스레드가 모드를 바꿀 때마다 computeLatencySamples 로 저장하는 현재 지연을 씀
+    const auto latencySeconds = 2.0 * pendingLatencySamples.load() / sampleRate;
+    
+    // 선형 위상 커널은 IIR 응답을 잘라 만든 것이므로 커널 길이가 곧 꼬리
+    if (parameterHandles.get(Parameter_LinearPhase) > 0.5f)
+        return latencySeconds;
+    
+    // 극점에서 계산한 IIR 캐스케이드의 감쇠 시간
+    return coefficientDesigner.getTailSeconds() + latencySeconds;
 }
 
 int NormalEQAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // 라이브러리가 없어도 1 (프로그램이 0 개면 문제가 생기는 호스트가 있음)
+    return juce::jmax(1, presetLibrary.getNumPresets());
 }
 
 int NormalEQAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentPreset;
 }
 
 void NormalEQAudioProcessor::setCurrentProgram (int index)
 {
+    recallPreset(index);
 }
 
 const juce::String NormalEQAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presetLibrary.getName(index);
 }
 
 void NormalEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
@@ -99,17 +189,96 @@ void NormalEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     // ProcessSpec 정의에서 가져옴
     // This structure is passed into a DSP algorithm's prepare() method, and contains
     // information about various aspects of the context in which it can expect to be called.
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = 1;
-    spec.sampleRate = sampleRate;
+    juce::dsp::ProcessSpec linearPhaseSpec;
+    linearPhaseSpec.maximumBlockSize = samplesPerBlock;
+    linearPhaseSpec.numChannels = getTotalNumOutputChannels();
+    linearPhaseSpec.sampleRate = sampleRate;
+    
+    linearPhaseEQ.prepare(linearPhaseSpec);
+    spectrumAnalyzer.prepare(sampleRate, getTotalNumOutputChannels());
+    linearPhaseIndex = static_cast<int>(parameterHandles.get(Parameter_LinearPhase));
     
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    // 프리셋 전환 시 계수 보간 길이 (원래 샘플 레이트 기준)
+    crossfadeSamples = juce::roundToInt(sampleRate * 0.03);
+    crossfadeWindowSamples = juce::roundToInt(sampleRate * 0.1);
+    crossfadeWindowRemaining = 0;
     
+    // 스무딩 시간 (주파수, Q 는 곱셈 스무딩으로 로그 스케일에서 일정하게 움직임)
+    const auto smoothingSeconds = 0.05;
+    lowCutFreqSmoother.reset(sampleRate, smoothingSeconds);
+    highCutFreqSmoother.reset(sampleRate, smoothingSeconds);
+    peakFreqSmoother.reset(sampleRate, smoothingSeconds);
+    peakQualitySmoother.reset(sampleRate, smoothingSeconds);
+    peakGainSmoother.reset(sampleRate, smoothingSeconds);
+    
+    for (int i = 0; i < numExtraBands; ++i)
+    {
+        bandFreqSmoothers[(size_t) i].reset(sampleRate, smoothingSeconds);
+        bandQualitySmoothers[(size_t) i].reset(sampleRate, smoothingSeconds);
+        bandGainSmoothers[(size_t) i].reset(sampleRate, smoothingSeconds);
+    }
 
-    updateFilters();
+    // 호스트는 prepareToPlay 전에 정밀도를 정하므로 쓰일 쪽만 준비
+    if (isUsingDoublePrecision())
+        prepareState<double>(samplesPerBlock);
+    else
+        prepareState<float>(samplesPerBlock);
+    
+    // 위에서 설계된 커널의 로드를 기다려서 첫 블록부터 크로스페이드 없이 쓰도록 함
+    linearPhaseEQ.loadPendingKernels();
     
+    // 재생 전이므로 호스트가 첫 블록 전에 알 수 있도록 바로 보고
+    cancelPendingUpdate();
+    updateLatency();
+}
+
+template <typename SampleType>
+void NormalEQAudioProcessor::prepareState(int samplesPerBlock)
+{
+    auto& state = getState<SampleType>();
+    state.prepare(getTotalNumOutputChannels(), samplesPerBlock, getSampleRate());
+    
+    // 다른 정밀도의 엔진이 쓰이다가 바뀐 경우에도 모드가 맞도록 맞춰 둠
+    state.filterEngine.setMidSide(midSide);
+    state.svfEngine.setMidSide(midSide);
+    
+    // 새로 만든 오버샘플러를 다시 고르도록 강제
+    oversamplingIndex = -1;
+    updateOversampling<SampleType>(static_cast<int>(parameterHandles.get(Parameter_Oversampling)),
+                                   static_cast<int>(parameterHandles.get(Parameter_OversamplingQuality)));
+    
+    updateFilters<SampleType>();
+}
+
+template <typename SampleType>
+void NormalEQAudioProcessor::ProcessingState<SampleType>::prepare(int numChannels, int samplesPerBlock, double sampleRate)
+{
+    using OversamplingType = juce::dsp::Oversampling<SampleType>;
+    
+    for (int quality = 0; quality < 2; ++quality)
+    {
+        const auto filterType = quality == 0 ? OversamplingType::filterHalfBandPolyphaseIIR
+                                             : OversamplingType::filterHalfBandFIREquiripple;
+        
+        for (int factor = 1; factor <= numOversamplingFactors; ++factor)
+        {
+            // 정수 지연으로 맞춰서 호스트에 정확한 지연을 보고할 수 있게 함
+            auto& oversampler = oversamplers[(size_t) (quality * numOversamplingFactors + factor - 1)];
+            oversampler = std::make_unique<OversamplingType>((size_t) numChannels, (size_t) factor,
+                                                             filterType, true, true);
+            oversampler->initProcessing((size_t) samplesPerBlock);
+        }
+    }
+    
+    activeOversampler = nullptr;
+    
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = samplesPerBlock << numOversamplingFactors;
+    spec.numChannels = numChannels;
+    spec.sampleRate = sampleRate;
+    
+    filterEngine.prepare(spec);
+    svfEngine.prepare(spec);
 }
 
 void NormalEQAudioProcessor::releaseResources()
@@ -125,12 +294,9 @@ bool NormalEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // 필터 엔진은 채널 수에 상관없이 모든 채널이 같은 계수를 공유하므로
+    // 모노, 스테레오뿐 아니라 5.1, 7.1, 7.1.4, 앰비소닉 등 입력과 출력이 같은 모든 레이아웃을 지원
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     // This checks if the input layout matches the output layout
@@ -145,8 +311,27 @@ bool NormalEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 #endif
 
 void NormalEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockImpl(buffer, midiMessages);
+}
+
+void NormalEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockImpl(buffer, midiMessages);
+}
+
+void NormalEQAudioProcessor::setNonRealtime (bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    coefficientDesigner.setOffline(isNonRealtime);
+}
+
+template <typename SampleType>
+void NormalEQAudioProcessor::processBlockImpl(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PerformanceCounters::ScopedBlock blockCounter(performanceCounters, buffer.getNumSamples(), getSampleRate());
+    
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -156,26 +341,442 @@ void NormalEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     
     // dsp::AudioBlock<> 인스턴스들은 juce::AudioBuffer<>와 함께 이루어진다.
     // 프로세스 블록 함수는 호스트에 의해 호출되고, 채널의 수에 따라 각각 버퍼가 주어진다.
-    // 따라서 이 버퍼를 통해 좌, 우 채널로 추출한다. channel {0, 1}
+    // 채널 수는 버스 레이아웃에 따라 1개(모노)부터 16개 이상(앰비소닉)까지 될 수 있다.
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
-    updateFilters();
+    juce::dsp::AudioBlock<SampleType> block(buffer); // 현재 버퍼로 블록이 초기화 됨
+    
+    updateControlOverrides();
+    
+    // 오프라인 렌더는 바뀐 값을 이 블록에서 바로 설계하고 커널 로드까지 기다림 (할당이 있어도 됨)
+    if (isNonRealtime() && coefficientDesigner.designPendingChanges()
+        && parameterHandles.get(Parameter_LinearPhase) >= 0.5f)
+        linearPhaseEQ.loadPendingKernels();
+    
+    // 분석기에는 복사만 하고 실제 분석은 분석 스레드에서
+    spectrumAnalyzer.push(SpectrumAnalyzer::preEQ, block);
+    
+    // 프리셋이 바뀌었으면 지금부터 도착하는 스냅샷을 보간해서 적용
+    if (presetRecalled.exchange(false))
+        crossfadeWindowRemaining = crossfadeWindowSamples;
+    else
+        crossfadeWindowRemaining = juce::jmax(0, crossfadeWindowRemaining - (int) block.getNumSamples());
+    
+    // 품질은 계수와 무관하므로 바로 반영, 배율은 스냅샷(또는 스무딩 경로)을 따라감
+    updateOversampling<SampleType>(oversamplingIndex, static_cast<int>(parameterHandles.get(Parameter_OversamplingQuality)));
+    
+    const auto newLinearPhaseIndex = static_cast<int>(parameterHandles.get(Parameter_LinearPhase));
+    
+    if (newLinearPhaseIndex != linearPhaseIndex)
+    {
+        linearPhaseIndex = newLinearPhaseIndex;
+        
+        if (linearPhaseIndex > 0)
+            linearPhaseEQ.reset(linearPhaseIndex - 1);
+        
+        reportLatencyAsync();
+    }
+    
+    // 구조를 바꾸면 새로 쓰일 엔진의 상태를 지우고 시작
+    auto& state = getState<SampleType>();
+    const auto newUseSVF = parameterHandles.get(Parameter_FilterStructure) > 0.5f;
+    
+    if (newUseSVF != state.useSVF)
+    {
+        state.useSVF = newUseSVF;
+        
+        if (state.useSVF)
+            state.svfEngine.reset();
+        else
+            state.filterEngine.reset();
+        
+        // 스무딩 경로는 선택된 엔진만 갱신하므로 다른 엔진의 계수는 오래되었을 수 있음
+        for (auto& changed : bandChanged)
+            changed.set(true);
+        
+        redesignImmediately = true;
+    }
+    
+    // 무음이 꼬리 길이보다 오래 이어지면 버퍼를 그대로 두고 끝냄 (필터의 출력도 무음 수준)
+    // 오프라인 렌더는 결과가 매번 같아야 하므로 멈추지 않음
+    if (! isNonRealtime() && isSilent(block))
+    {
+        silentSamples += (juce::int64) block.getNumSamples();
+        
+        if (silentSamples > (juce::int64) std::ceil(getTailLengthSeconds() * getSampleRate()))
+        {
+            processingSuspended = true;
+            applyControlChanges(midiMessages);
+            spectrumAnalyzer.push(SpectrumAnalyzer::postEQ, block);
+            return;
+        }
+    }
+    else
+    {
+        silentSamples = 0;
+        
+        if (processingSuspended)
+        {
+            processingSuspended = false;
+            resetProcessingState();
+        }
+    }
+    
+    // 선형 위상 모드에서는 IIR 엔진과 오버샘플링을 거치지 않음
+    // 커널은 설계 스레드에서 만들어지므로 샘플 단위로 맞출 수 없음
+    if (linearPhaseIndex > 0)
+    {
+        applyControlChanges(midiMessages);
+        linearPhaseEQ.process(block, linearPhaseIndex - 1);
+        spectrumAnalyzer.push(SpectrumAnalyzer::postEQ, block);
+        return;
+    }
+    
+    // 0 = Off, 1 = 16, 2 = 32, 3 = 64 샘플
+    const auto smoothingIndex = static_cast<int>(parameterHandles.get(Parameter_Smoothing));
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+    
+    // MIDI CC 의 타임스탬프에서 블록을 나눠서 그 샘플부터 바뀐 계수로 처리
+    // 이벤트가 촘촘하면 minimumSegmentLength 보다 짧은 구간은 만들지 않고 구간 시작에 모아서 적용 (최대 15 샘플 일찍)
+    // (컨트롤러를 빠르게 돌려도 나누는 횟수는 블록 길이 / minimumSegmentLength 를 넘지 않음)
+    std::array<bool, numBands> controlledBands {};
+    auto segmentStart = 0;
+    
+    for (const auto metadata : midiMessages)
+    {
+        auto value = 0.0f;
+        const auto parameter = getControlledParameter(metadata, value);
+        
+        if (! parameter)
+            continue;
+        
+        const auto position = juce::jlimit(0, numSamples, metadata.samplePosition);
+        
+        if (position - segmentStart >= minimumSegmentLength)
+        {
+            auto segment = block.getSubBlock((size_t) segmentStart, (size_t) (position - segmentStart));
+            processSegment(segment, smoothingIndex, controlledBands);
+            segmentStart = position;
+        }
+        
+        if (const auto band = setControlledValue(*parameter, value))
+            controlledBands[(size_t) *band] = true;
+    }
+    
+    if (segmentStart < numSamples)
+    {
+        auto segment = block.getSubBlock((size_t) segmentStart, (size_t) (numSamples - segmentStart));
+        processSegment(segment, smoothingIndex, controlledBands);
+    }
+    
+    performanceCounters.setActiveSections(state.getNumActiveSections(), SIMDFilterEngine<SampleType>::maxSections);
+    spectrumAnalyzer.push(SpectrumAnalyzer::postEQ, block);
+}
+
+template <typename SampleType>
+void NormalEQAudioProcessor::processSegment(juce::dsp::AudioBlock<SampleType>& block, int smoothingIndex,
+                                            std::array<bool, numBands>& controlledBands)
+{
+    // 스무딩 경로는 setControlledValue 가 세운 bandChanged 로 바뀐 값을 바로 가져감
+    if (smoothingIndex > 0)
+    {
+        controlledBands.fill(false);
+        processSmoothed(block, 8 << smoothingIndex);
+        return;
+    }
+    
+    const auto anyControlled = std::find(controlledBands.begin(), controlledBands.end(), true) != controlledBands.end();
+    
+    applyLatestSnapshot<SampleType>();
+    
+    // 설계 스레드를 기다리지 않고 CC 로 바뀐 밴드만 여기서 바로 설계
+    // CC 는 기본 세 밴드의 파라미터에만 배정되므로 (midiControllerParameters) 추가 밴드는 볼 필요 없음
+    if (anyControlled)
+    {
+        const auto chainSettings = getChainSettings(parameterHandles, controlOverrides);
+        
+        if (controlledBands[ChainPosition::LowCut])
+            updateLowCutFilters<SampleType>(chainSettings);
+        if (controlledBands[ChainPosition::Peak])
+            updatePeakFilter<SampleType>(chainSettings);
+        if (controlledBands[ChainPosition::HighCut])
+            updateHighCutFilters<SampleType>(chainSettings);
+        
+        controlledBands.fill(false);
+        performanceCounters.addRedesign();
+    }
+    
+    getState<SampleType>().process(block);
+}
+
+std::optional<ParameterIndex> NormalEQAudioProcessor::getControlledParameter(const juce::MidiMessageMetadata& metadata,
+                                                                            float& value) noexcept
+{
+    if (metadata.numBytes < 3 || (metadata.data[0] & 0xf0) != 0xb0)
+        return std::nullopt;
+    
+    const auto controller = metadata.data[1] & 0x7f;
+    const auto controllerValue = metadata.data[2] & 0x7f;
     
+    // MSB 만 보내는 컨트롤러도 끝까지 움직일 수 있도록 7 비트 값은 127 로 나눔
+    if (controller < 32)
+    {
+        midiControllerMSB[(size_t) controller] = controllerValue;
+        value = (float) controllerValue / 127.0f;
+        return midiControllerParameters[(size_t) controller];
+    }
+    
+    if (controller < 64)
+    {
+        const auto msb = midiControllerMSB[(size_t) (controller - 32)];
+        value = (float) (msb * 128 + controllerValue) / 16383.0f;
+        return midiControllerParameters[(size_t) (controller - 32)];
+    }
+    
+    value = (float) controllerValue / 127.0f;
+    return midiControllerParameters[(size_t) controller];
+}
+
+std::optional<int> NormalEQAudioProcessor::setControlledValue(ParameterIndex parameter, float value)
+{
+    const auto& rangedParameter = parameterHandles.getParameter(parameter);
+    const auto currentValue = controlOverrides.active[(size_t) parameter]
+                            ? rangedParameter.convertTo0to1(controlOverrides.values[(size_t) parameter])
+                            : rangedParameter.getValue();
+    
+    if (currentValue == value)
+        return std::nullopt;
+    
+    controlOverrides.values[(size_t) parameter] = rangedParameter.convertFrom0to1(value);
+    controlOverrides.active[(size_t) parameter] = true;
+    unsentControlChanges[(size_t) parameter] = true;
+    controlChangesPending = true;
+    sendControlChanges();
+    
+    // 리스너가 불리지 않으므로 스무딩 경로가 목표값을 다시 읽도록 직접 표시
+    const auto band = parameterBands[(size_t) rangedParameter.getParameterIndex()];
+    
+    if (band)
+        bandChanged[(size_t) *band].set(true);
+    
+    return band;
+}
+
+void NormalEQAudioProcessor::applyControlChanges(const juce::MidiBuffer& midiMessages)
+{
+    for (const auto metadata : midiMessages)
+    {
+        auto value = 0.0f;
+        
+        if (const auto parameter = getControlledParameter(metadata, value))
+            setControlledValue(*parameter, value);
+    }
+}
+
+void NormalEQAudioProcessor::sendControlChanges()
+{
+    // 큐는 메시지 스레드의 타이머가 비움
+    for (size_t i = 0; i < (size_t) numParameters; ++i)
+    {
+        if (! unsentControlChanges[i])
+            continue;
+        
+        // 가득 차면 남은 값은 다음 블록에서 다시 보냄, 파라미터마다 마지막 값만 있으면 됨
+        const auto scope = controlChangeFifo.write(1);
+        
+        if (scope.blockSize1 + scope.blockSize2 == 0)
+            break;
+        
+        const auto parameter = static_cast<ParameterIndex>(i);
+        const auto value = parameterHandles.getParameter(parameter).convertTo0to1(controlOverrides.values[i]);
+        scope.forEach([&](int index) { controlChangeQueue[(size_t) index] = { parameter, value }; });
+        
+        unsentControlChanges[i] = false;
+        ++sentControlChanges;
+    }
+}
+
+void NormalEQAudioProcessor::updateControlOverrides()
+{
+    if (! controlChangesPending)
+        return;
+    
+    sendControlChanges();
+    
+    if (std::find(unsentControlChanges.begin(), unsentControlChanges.end(), true) != unsentControlChanges.end()
+        || appliedControlChanges.load(std::memory_order_acquire) != sentControlChanges)
+        return;
+    
+    // 파라미터가 CC 값을 따라잡았으므로 이후 설계된 스냅샷부터 받고 파라미터 값을 다시 씀
+    // 그 사이 호스트나 에디터가 바꾼 값이 있으면 그 값이 이김
+    requiredChangeSerial = appliedControlSerial.load(std::memory_order_acquire);
+    controlOverrides.active.fill(false);
+    controlChangesPending = false;
+}
+
+template <typename SampleType>
+bool NormalEQAudioProcessor::isSilent(const juce::dsp::AudioBlock<SampleType>& block)
+{
+    // -140 dBFS 아래는 무음으로 취급 (디더나 디노멀 수준의 잡음)
+    const auto threshold = static_cast<SampleType>(1.0e-7);
+    
+    for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(ch),
+                                                                      (int) block.getNumSamples());
+        
+        if (range.getStart() < -threshold || range.getEnd() > threshold)
+            return false;
+    }
+    
+    return true;
+}
+
+void NormalEQAudioProcessor::resetProcessingState()
+{
+    // 쉬는 동안 감쇠하다 멈춘 상태가 새 입력에 섞이지 않도록 지움
+    if (isUsingDoublePrecision())
+        doubleState.selectOversampler(oversamplingIndex, oversamplingQuality);
+    else
+        floatState.selectOversampler(oversamplingIndex, oversamplingQuality);
+    
+    if (linearPhaseIndex > 0)
+        linearPhaseEQ.reset(linearPhaseIndex - 1);
+}
+
+template <typename SampleType>
+void NormalEQAudioProcessor::ProcessingState<SampleType>::process(juce::dsp::AudioBlock<SampleType>& block)
+{
+    if (useSVF)
+        processWith(svfEngine, block);
+    else
+        processWith(filterEngine, block);
+}
+
+template <typename SampleType>
+template <typename EngineType>
+void NormalEQAudioProcessor::ProcessingState<SampleType>::processWith(EngineType& engine, juce::dsp::AudioBlock<SampleType>& block)
+{
+    // 채널을 따로 나누지 않고 엔진이 한 번에 처리 (각 채널이 SIMD 레인 하나)
+    if (activeOversampler == nullptr)
+    {
+        juce::dsp::ProcessContextReplacing<SampleType> context(block);
+        engine.process(context);
+        return;
+    }
+    
+    auto oversampledBlock = activeOversampler->processSamplesUp(block);
+    juce::dsp::ProcessContextReplacing<SampleType> context(oversampledBlock);
+    engine.process(context);
+    activeOversampler->processSamplesDown(block);
+}
+
+template <typename SampleType>
+void NormalEQAudioProcessor::ProcessingState<SampleType>::selectOversampler(int index, int quality)
+{
+    activeOversampler = index > 0
+                      ? oversamplers[(size_t) (quality * numOversamplingFactors + index - 1)].get()
+                      : nullptr;
+    
+    // 이전에 쓰던 상태가 남아 있지 않도록 초기화, 샘플 레이트가 바뀌므로 필터 상태도 초기화
+    if (activeOversampler != nullptr)
+        activeOversampler->reset();
+    
+    filterEngine.reset();
+    svfEngine.reset();
+}
+
+template <typename SampleType>
+int NormalEQAudioProcessor::ProcessingState<SampleType>::getOversamplerLatency() const
+{
+    return activeOversampler != nullptr ? juce::roundToInt(activeOversampler->getLatencyInSamples()) : 0;
+}
+
+template <typename SampleType>
+void NormalEQAudioProcessor::updateOversampling(int newIndex, int newQuality)
+{
+    if (newIndex == oversamplingIndex && newQuality == oversamplingQuality)
+        return;
+    
+    oversamplingIndex = juce::jlimit(0, numOversamplingFactors, newIndex);
+    oversamplingQuality = juce::jlimit(0, 1, newQuality);
+    
+    getState<SampleType>().selectOversampler(oversamplingIndex, oversamplingQuality);
     
-    juce::dsp::AudioBlock<float> block(buffer); // 현재 버퍼로 블록이 초기화 됨
+    // 처리 중(스냅샷 적용, 스무딩 경로)에도 불리므로 보고는 메시지 스레드로 넘김
+    reportLatencyAsync();
+}
+
+template <typename SampleType>
+bool NormalEQAudioProcessor::updateStereoMode(bool shouldUseMidSide)
+{
+    shouldUseMidSide = shouldUseMidSide && getTotalNumOutputChannels() == 2;
     
-    // audioBlock<> 클래스에서 수 많은 블록이 담긴 버퍼로부터 개별 채널을 추출할 수 있는 도우미 기능
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+    if (shouldUseMidSide == midSide)
+        return false;
     
-    // 이제 각 개별 채널 블록이 있으므로 그들을 래핑하는 컨텍스트를 만들어 줌 = 체인에서 사용 가능하도록
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+    midSide = shouldUseMidSide;
     
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    auto& state = getState<SampleType>();
+    state.filterEngine.setMidSide(midSide);
+    state.svfEngine.setMidSide(midSide);
+    return true;
+}
 
+juce::uint32 NormalEQAudioProcessor::getLaneMask(Placement placement) const noexcept
+{
+    using Engine = SIMDFilterEngine<float>;
+    
+    if (! midSide || placement == Placement_Stereo)
+        return Engine::allLanes;
+    
+    return placement == Placement_Mid ? Engine::midLane : Engine::sideLane;
+}
+
+void NormalEQAudioProcessor::updateLatency()
+{
+    // 나중에 타이머가 이전 값을 보고하지 않도록 함께 저장
+    pendingLatencySamples.store(computeLatencySamples());
+    setLatencySamples(pendingLatencySamples.load());
+}
+
+int NormalEQAudioProcessor::computeLatencySamples() const
+{
+    if (linearPhaseIndex > 0)
+        return linearPhaseEQ.getLatencySamples(linearPhaseIndex - 1);
+    
+    return isUsingDoublePrecision() ? doubleState.getOversamplerLatency()
+                                    : floatState.getOversamplerLatency();
+}
+
+void NormalEQAudioProcessor::reportLatencyAsync()
+{
+    pendingLatencySamples.store(computeLatencySamples());
+}
+
+void NormalEQAudioProcessor::timerCallback()
+{
+    const auto latencySamples = pendingLatencySamples.load();
+    
+    if (latencySamples != getLatencySamples())
+        setLatencySamples(latencySamples);
+    
+    // 오디오 스레드가 이미 그 값으로 처리하고 있으므로 여기서는 호스트와 설계 스레드에 알리기만 함
+    const auto scope = controlChangeFifo.read(controlChangeFifo.getNumReady());
+    
+    scope.forEach([this](int index)
+    {
+        const auto& change = controlChangeQueue[(size_t) index];
+        parameterHandles.getParameter(change.parameter).setValueNotifyingHost(change.value);
+    });
+    
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+        return;
+    
+    // 리스너가 변경 번호를 올린 뒤에 읽으므로 이 번호 이후의 스냅샷에는 위의 값이 들어 있음
+    appliedControlSerial.store(coefficientDesigner.getChangeSerial(), std::memory_order_release);
+    appliedControlChanges.fetch_add((juce::uint32) (scope.blockSize1 + scope.blockSize2), std::memory_order_release);
 }
 
 //==============================================================================
@@ -193,55 +794,310 @@ juce::AudioProcessorEditor* NormalEQAudioProcessor::createEditor()
 //==============================================================================
 void NormalEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // MemoryOutputStream에서 가져옴
-    // Writes data to an internal memory buffer, which grows as required.
-    // The data that was written into the stream can then be accessed later as a contiguous block of memory.
+    // ValueTree 대신 (키, 실제 값) 쌍만 저장, 파라미터 하나에 8 바이트
+    std::vector<CompactState::Entry> entries;
+    entries.reserve(parametersByKey.size());
+    
+    for (const auto& keyed : parametersByKey)
+        entries.push_back({ keyed.key, keyed.parameter->convertFrom0to1(keyed.parameter->getValue()) });
     
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+    CompactState::write(destData, entries);
 }
 
 void NormalEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // 메모리 블록에 저장해뒀던 파라미터 값으로 복원할 수 있다
+    std::vector<CompactState::Entry> entries;
+    
+    if (CompactState::read(data, sizeInBytes, entries))
+    {
+        applyParameterValues(entries);
+        markAllBandsChanged();
+        return;
+    }
     
+    // 예전 버전이 저장한 ValueTree 형식
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if( tree.isValid() )
     {
         apvts.replaceState(tree);
-        updateFilters();
+        // 필터 설계는 설계 스레드가 처리
+        markAllBandsChanged();
     }
 }
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+juce::RangedAudioParameter* NormalEQAudioProcessor::findParameter(juce::uint32 key) const noexcept
+{
+    const auto it = std::lower_bound(parametersByKey.begin(), parametersByKey.end(), key,
+                                     [](const auto& keyed, juce::uint32 k) { return keyed.key < k; });
+    
+    return it != parametersByKey.end() && it->key == key ? it->parameter : nullptr;
+}
+
+void NormalEQAudioProcessor::applyParameterValues(const std::vector<CompactState::Entry>& entries)
+{
+    // replaceState 와 같이 상태에 없는 파라미터는 기본값으로 되돌림
+    std::vector<float> values;
+    values.reserve(parametersByKey.size());
+    
+    for (const auto& keyed : parametersByKey)
+        values.push_back(keyed.parameter->getDefaultValue());
+    
+    for (const auto& entry : entries)
+    {
+        const auto it = std::lower_bound(parametersByKey.begin(), parametersByKey.end(), entry.key,
+                                         [](const auto& keyed, juce::uint32 k) { return keyed.key < k; });
+        
+        // 지금 버전에 없는 파라미터는 무시
+        if (it != parametersByKey.end() && it->key == entry.key)
+            values[(size_t) std::distance(parametersByKey.begin(), it)] = it->parameter->convertTo0to1(entry.value);
+    }
+    
+    for (size_t i = 0; i < parametersByKey.size(); ++i)
+    {
+        auto* parameter = parametersByKey[i].parameter;
+        
+        if (parameter->getValue() != values[i])
+            parameter->setValueNotifyingHost(values[i]);
+    }
+}
+
+juce::File NormalEQAudioProcessor::getDefaultPresetLibraryFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("normalEQ")
+               .getChildFile("Presets.neqlib");
+}
+
+bool NormalEQAudioProcessor::loadPresetLibrary(const juce::File& file)
+{
+    presetParameters.clear();
+    currentPreset = 0;
+    
+    const auto opened = presetLibrary.open(file);
+    
+    // 키 -> 파라미터 연결은 여기서 한 번만, 프리셋을 고를 때는 인덱스로 바로 접근
+    for (int i = 0; i < presetLibrary.getNumParameters(); ++i)
+        presetParameters.push_back(findParameter(presetLibrary.getParameterKey(i)));
+    
+    // 프로그램 목록이 바뀌었음을 호스트에 알림
+    updateHostDisplay();
+    
+    return opened;
+}
+
+void NormalEQAudioProcessor::recallPreset(int index)
+{
+    if (! juce::isPositiveAndBelow(index, presetLibrary.getNumPresets()))
+        return;
+    
+    currentPreset = index;
+    
+    // 값을 바꾸기 전에 세워 둠, 설계 스레드가 중간에 발행한 스냅샷도 보간되도록
+    presetRecalled.store(true);
+    
+    // 라이브러리에 없는 파라미터 (오버샘플링 등) 는 그대로 둠
+    for (size_t i = 0; i < presetParameters.size(); ++i)
+    {
+        if (auto* parameter = presetParameters[i])
+        {
+            const auto value = parameter->convertTo0to1(presetLibrary.getValue(index, (int) i));
+            
+            if (parameter->getValue() != value)
+                parameter->setValueNotifyingHost(value);
+        }
+    }
+}
+
+std::optional<int> getBandIndex(const juce::String& parameterID)
+{
+    if (parameterID.startsWith("LowCut"))
+        return ChainPosition::LowCut;
+    
+    if (parameterID.startsWith("HighCut"))
+        return ChainPosition::HighCut;
+    
+    if (parameterID.startsWith("Peak"))
+        return ChainPosition::Peak;
+    
+    // "Band 4 Freq" -> 3
+    if (parameterID.startsWith("Band "))
+        return parameterID.fromFirstOccurrenceOf("Band ", false, false).getIntValue() - 1;
+    
+    return std::nullopt;
+}
+
+bool isLowCutNeutral(const ChainSettings& chainSettings)
+{
+    return chainSettings.lowCutFreq <= 20.f;
+}
+
+bool isHighCutNeutral(const ChainSettings& chainSettings)
+{
+    return chainSettings.highCutFreq >= 20000.f;
+}
+
+bool isPeakNeutral(const ChainSettings& chainSettings)
+{
+    // Peak Gain 의 간격이 0.1 dB 이므로 그보다 작으면 0 dB
+    return std::abs(chainSettings.peakGainInDecibels) < 0.01f;
+}
+
+bool isBandNeutral(const ChainSettings& chainSettings, int extraBand)
+{
+    const auto type = chainSettings.bands.type[(size_t) extraBand];
+    
+    // 노치는 이득과 상관없이 항상 소리를 바꿈
+    if (type == BandType_Notch)
+        return false;
+    
+    return type == BandType_Off || std::abs(chainSettings.bands.gainInDecibels[(size_t) extraBand]) < 0.01f;
+}
+
+int designLowCutSections(const ChainSettings& chainSettings, double sampleRate,
+                         std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections>& sections)
+{
+    if (isLowCutNeutral(chainSettings))
+        return 0;
+    
+    return makeBiquadButterworth(true, chainSettings.lowCutFreq, getLowCutOrder(chainSettings), sampleRate,
+                                 sections.data(), (int) sections.size());
+}
+
+int designLowCutSections(const ChainSettings& chainSettings, double sampleRate,
+                         std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections>& sections)
+{
+    if (isLowCutNeutral(chainSettings))
+        return 0;
+    
+    return makeSVFButterworth(true, chainSettings.lowCutFreq, getLowCutOrder(chainSettings), sampleRate,
+                              sections.data(), (int) sections.size());
+}
+
+int designHighCutSections(const ChainSettings& chainSettings, double sampleRate,
+                          std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections>& sections)
+{
+    if (isHighCutNeutral(chainSettings))
+        return 0;
+    
+    return makeBiquadButterworth(false, chainSettings.highCutFreq, getHighCutOrder(chainSettings), sampleRate,
+                                 sections.data(), (int) sections.size());
+}
+
+int designHighCutSections(const ChainSettings& chainSettings, double sampleRate,
+                          std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections>& sections)
+{
+    if (isHighCutNeutral(chainSettings))
+        return 0;
+    
+    return makeSVFButterworth(false, chainSettings.highCutFreq, getHighCutOrder(chainSettings), sampleRate,
+                              sections.data(), (int) sections.size());
+}
+
+BiquadCoefficients<double> designPeakSection(const ChainSettings& chainSettings, double sampleRate)
+{
+    // 기본값이 항등 계수, 엔진은 이를 보고 피크 섹션을 건너뜀
+    if (isPeakNeutral(chainSettings))
+        return {};
+    
+    return makeBiquadPeak<double>(chainSettings.peakFreq, chainSettings.peakQuality,
+                                  juce::Decibels::decibelsToGain((double) chainSettings.peakGainInDecibels), sampleRate);
+}
+
+SVFCoefficients<double> designPeakSVFSection(const ChainSettings& chainSettings, double sampleRate)
+{
+    if (isPeakNeutral(chainSettings))
+        return {};
+    
+    return makeSVFPeak<double>(chainSettings.peakFreq, chainSettings.peakQuality,
+                               chainSettings.peakGainInDecibels, sampleRate);
+}
+
+BiquadCoefficients<double> designBandSection(const ChainSettings& chainSettings, int extraBand, double sampleRate)
+{
+    if (isBandNeutral(chainSettings, extraBand))
+        return {};
+    
+    const auto& bands = chainSettings.bands;
+    const auto i = (size_t) extraBand;
+    const auto freq = (double) bands.freq[i];
+    const auto quality = (double) bands.quality[i];
+    const auto gain = juce::Decibels::decibelsToGain((double) bands.gainInDecibels[i]);
+    
+    switch (bands.type[i])
+    {
+        case BandType_Peak:      return makeBiquadPeak<double>(freq, quality, gain, sampleRate);
+        case BandType_LowShelf:  return makeBiquadLowShelf<double>(freq, quality, gain, sampleRate);
+        case BandType_HighShelf: return makeBiquadHighShelf<double>(freq, quality, gain, sampleRate);
+        case BandType_Notch:     return makeBiquadNotch<double>(freq, quality, sampleRate);
+        case BandType_Off:
+        default:                 return {};
+    }
+}
+
+SVFCoefficients<double> designBandSVFSection(const ChainSettings& chainSettings, int extraBand, double sampleRate)
+{
+    if (isBandNeutral(chainSettings, extraBand))
+        return {};
+    
+    const auto& bands = chainSettings.bands;
+    const auto i = (size_t) extraBand;
+    const auto freq = (double) bands.freq[i];
+    const auto quality = (double) bands.quality[i];
+    const auto gainInDecibels = (double) bands.gainInDecibels[i];
+    
+    switch (bands.type[i])
+    {
+        case BandType_Peak:      return makeSVFPeak<double>(freq, quality, gainInDecibels, sampleRate);
+        case BandType_LowShelf:  return makeSVFLowShelf<double>(freq, quality, gainInDecibels, sampleRate);
+        case BandType_HighShelf: return makeSVFHighShelf<double>(freq, quality, gainInDecibels, sampleRate);
+        case BandType_Notch:     return makeSVFNotch<double>(freq, quality, sampleRate);
+        case BandType_Off:
+        default:                 return {};
+    }
+}
+
+ChainSettings getChainSettings(const ParameterHandles& parameters)
+{
+    static const ParameterOverrides noOverrides;
+    return getChainSettings(parameters, noOverrides);
+}
+
+ChainSettings getChainSettings(const ParameterHandles& parameters, const ParameterOverrides& overrides)
 {
     ChainSettings settings;
-    // thread의 안전 상 이슈가 존재하지만 여기선 다루지 않음
-    // apvts.getParameter("LowCut Freq")->getValue(); 이 경우 정규화된 값이 주어지기 때문에 사용 x
     
     // 아래 파라미터 레이아웃에서 설정했던 파라미터 값을 받을 수 있게 됨
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDecibels = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
+    // (정규화된 값이 아닌 실제 값)
+    settings.lowCutFreq = overrides.get(parameters, Parameter_LowCutFreq);
+    settings.highCutFreq = overrides.get(parameters, Parameter_HighCutFreq);
+    settings.peakFreq = overrides.get(parameters, Parameter_PeakFreq);
+    settings.peakGainInDecibels = overrides.get(parameters, Parameter_PeakGain);
+    settings.peakQuality = overrides.get(parameters, Parameter_PeakQuality);
     
     // Slope로 명시적 형변환
-    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
-    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
+    settings.lowCutSlope = static_cast<Slope>(overrides.get(parameters, Parameter_LowCutSlope));
+    settings.highCutSlope = static_cast<Slope>(overrides.get(parameters, Parameter_HighCutSlope));
+    
+    settings.lowCutPlacement = static_cast<Placement>(overrides.get(parameters, Parameter_LowCutPlacement));
+    settings.peakPlacement = static_cast<Placement>(overrides.get(parameters, Parameter_PeakPlacement));
+    settings.highCutPlacement = static_cast<Placement>(overrides.get(parameters, Parameter_HighCutPlacement));
+    
+    for (size_t i = 0; i < (size_t) numExtraBands; ++i)
+    {
+        const auto band = (int) i;
+        settings.bands.type[i] = static_cast<BandType>(parameters.getBand(band, BandParameter_Type));
+        settings.bands.freq[i] = parameters.getBand(band, BandParameter_Freq);
+        settings.bands.gainInDecibels[i] = parameters.getBand(band, BandParameter_Gain);
+        settings.bands.quality[i] = parameters.getBand(band, BandParameter_Quality);
+        settings.bands.placement[i] = static_cast<Placement>(parameters.getBand(band, BandParameter_Placement));
+    }
     
     return settings;
 }
 
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-                                                               chainSettings.peakFreq,
-                                                               chainSettings.peakQuality,
-                                                               juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
-}
-
-void NormalEQAudioProcessor::updatePeakFilter(const ChainSettings &chainSettings)
+template <typename SampleType>
+void NormalEQAudioProcessor::updatePeakFilter(const ChainSettings &chainSettings, int rampLength)
 {
     // 피크의 계수를 설정
     // auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(getSampleRate(),
@@ -256,96 +1112,461 @@ void NormalEQAudioProcessor::updatePeakFilter(const ChainSettings &chainSettings
     
     // 리팩토링
     // update filter > make filter > update coefficients > update filter
-    auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate());
+    // 스무딩 경로는 지금 쓰이는 엔진의 형태로만 설계
+    auto& state = getState<SampleType>();
     
-    updateCoefficients(leftChain.get<ChainPosition::Peak>().coefficients, peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPosition::Peak>().coefficients, peakCoefficients);
+    if (state.useSVF)
+        state.svfEngine.setPeak(designPeakSVFSection(chainSettings, getProcessingSampleRate()), rampLength,
+                                getLaneMask(chainSettings.peakPlacement));
+    else
+        state.filterEngine.setPeak(designPeakSection(chainSettings, getProcessingSampleRate()), rampLength,
+                                   getLaneMask(chainSettings.peakPlacement));
 }
 
-void updateCoefficients(Coefficients &old, const Coefficients &replacements)
+template <typename SampleType>
+void NormalEQAudioProcessor::updateLowCutFilters(const ChainSettings &chainSettings, int rampLength)
 {
-    //
-    *old = *replacements;
+    auto& state = getState<SampleType>();
+    
+    if (state.useSVF)
+    {
+        std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+        const auto numSections = designLowCutSections(chainSettings, getProcessingSampleRate(), sections);
+        state.svfEngine.setLowCut(sections.data(), numSections, rampLength, getLaneMask(chainSettings.lowCutPlacement));
+    }
+    else
+    {
+        std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+        const auto numSections = designLowCutSections(chainSettings, getProcessingSampleRate(), sections);
+        state.filterEngine.setLowCut(sections.data(), numSections, rampLength, getLaneMask(chainSettings.lowCutPlacement));
+    }
 }
 
-void NormalEQAudioProcessor::updateLowCutFilters(const ChainSettings &chainSettings)
+template <typename SampleType>
+void NormalEQAudioProcessor::updateHighCutFilters(const ChainSettings &chainSettings, int rampLength)
 {
-    auto cutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
-    auto& leftLowCut = leftChain.get<ChainPosition::LowCut>();
-    auto& rightLowCut = rightChain.get<ChainPosition::LowCut>();
-    updateCutFilter(leftLowCut, cutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(rightLowCut, cutCoefficients, chainSettings.lowCutSlope);
+    auto& state = getState<SampleType>();
+    
+    if (state.useSVF)
+    {
+        std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+        const auto numSections = designHighCutSections(chainSettings, getProcessingSampleRate(), sections);
+        state.svfEngine.setHighCut(sections.data(), numSections, rampLength, getLaneMask(chainSettings.highCutPlacement));
+    }
+    else
+    {
+        std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+        const auto numSections = designHighCutSections(chainSettings, getProcessingSampleRate(), sections);
+        state.filterEngine.setHighCut(sections.data(), numSections, rampLength, getLaneMask(chainSettings.highCutPlacement));
+    }
 }
 
-void NormalEQAudioProcessor::updateHighCutFilters(const ChainSettings &chainSettings)
+template <typename SampleType>
+void NormalEQAudioProcessor::updateBandFilter(const ChainSettings& chainSettings, int extraBand, int rampLength)
 {
-    auto cutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
+    auto& state = getState<SampleType>();
+    
+    const auto bandLanes = getLaneMask(chainSettings.bands.placement[(size_t) extraBand]);
     
-    auto& leftHighCut = leftChain.get<ChainPosition::HighCut>();
-    auto& rightHighCut = rightChain.get<ChainPosition::HighCut>();
-    updateCutFilter(leftHighCut, cutCoefficients, chainSettings.highCutSlope);
-    updateCutFilter(rightHighCut, cutCoefficients, chainSettings.highCutSlope);
+    if (state.useSVF)
+        state.svfEngine.setBand(extraBand, designBandSVFSection(chainSettings, extraBand, getProcessingSampleRate()), rampLength, bandLanes);
+    else
+        state.filterEngine.setBand(extraBand, designBandSection(chainSettings, extraBand, getProcessingSampleRate()), rampLength, bandLanes);
 }
 
+template <typename SampleType>
 void NormalEQAudioProcessor::updateFilters()
 {
     // 모든 필터들의 업데이트를 한 곳에 모아서 리팩토링함
-    auto chainSettings = getChainSettings(apvts);
-    updateLowCutFilters(chainSettings);
-    updatePeakFilter(chainSettings);
-    updateHighCutFilters(chainSettings);
+    // prepareToPlay 에서만 호출되므로 여기서는 설계가 끝날 때까지 기다려도 됨
+    coefficientDesigner.prepare(getSampleRate());
+    applyLatestSnapshot<SampleType>();
 }
 
-juce::AudioProcessorValueTreeState::ParameterLayout NormalEQAudioProcessor::createParameterLayout()
+template <typename SampleType>
+void NormalEQAudioProcessor::applyLatestSnapshot()
 {
-    // AudioProcessorParameter Diagram 참고
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+    // 새 스냅샷이 있을 때만 인덱스를 교환하고 계수를 옮김, 설계도 할당도 없음
+    if (auto* snapshot = coefficientDesigner.acquireLatest())
+    {
+        // CC 로 바꾼 값이 파라미터에 반영되기 전에 설계된 스냅샷, 그 값을 반영한 스냅샷이 곧 따라옴
+        if (controlChangesPending || (juce::int32) (snapshot->changeSerial - requiredChangeSerial) < 0)
+            return;
+        
+        // 배율이 바뀐 경우 그 배율로 설계된 계수가 도착했을 때 함께 전환
+        const auto previousOversamplingIndex = oversamplingIndex;
+        updateOversampling<SampleType>(snapshot->oversamplingIndex, oversamplingQuality);
+        const auto stereoModeChanged = updateStereoMode<SampleType>(snapshot->midSide);
+        
+        // 프리셋을 바꾼 직후면 이전 계수에서 새 계수로 보간
+        // 배율이나 Mid/Side 모드가 바뀌었으면 엔진 상태가 초기화되었으므로 보간하지 않음
+        const auto rampLength = crossfadeWindowRemaining > 0 && oversamplingIndex == previousOversamplingIndex
+                                && ! stereoModeChanged
+                              ? crossfadeSamples << oversamplingIndex
+                              : 0;
+        
+        const auto& settings = snapshot->settings;
+        const auto lowCutLanes = getLaneMask(settings.lowCutPlacement);
+        const auto peakLanes = getLaneMask(settings.peakPlacement);
+        const auto highCutLanes = getLaneMask(settings.highCutPlacement);
+        
+        // 두 엔진 모두 갱신해 두므로 구조를 바꿔도 바로 맞는 계수로 처리
+        auto& state = getState<SampleType>();
+        state.filterEngine.setLowCut(snapshot->lowCut.data(), snapshot->numLowCutSections, rampLength, lowCutLanes);
+        state.filterEngine.setPeak(snapshot->peak, rampLength, peakLanes);
+        state.filterEngine.setHighCut(snapshot->highCut.data(), snapshot->numHighCutSections, rampLength, highCutLanes);
+        
+        state.svfEngine.setLowCut(snapshot->svfLowCut.data(), snapshot->numLowCutSections, rampLength, lowCutLanes);
+        state.svfEngine.setPeak(snapshot->svfPeak, rampLength, peakLanes);
+        state.svfEngine.setHighCut(snapshot->svfHighCut.data(), snapshot->numHighCutSections, rampLength, highCutLanes);
+        
+        for (int i = 0; i < numExtraBands; ++i)
+        {
+            const auto bandLanes = getLaneMask(settings.bands.placement[(size_t) i]);
+            state.filterEngine.setBand(i, snapshot->bands[(size_t) i], rampLength, bandLanes);
+            state.svfEngine.setBand(i, snapshot->svfBands[(size_t) i], rampLength, bandLanes);
+        }
+        
+        // 스무딩 모드로 바뀌었을 때 예전 값에서 미끄러지지 않도록 맞춰 둠
+        resetSmoothers(snapshot->settings);
+        
+        performanceCounters.addRedesign();
+    }
+}
+
+void NormalEQAudioProcessor::resetSmoothers(const ChainSettings& chainSettings)
+{
+    targetSettings = chainSettings;
+    lowCutFreqSmoother.setCurrentAndTargetValue(chainSettings.lowCutFreq);
+    highCutFreqSmoother.setCurrentAndTargetValue(chainSettings.highCutFreq);
+    peakFreqSmoother.setCurrentAndTargetValue(chainSettings.peakFreq);
+    peakQualitySmoother.setCurrentAndTargetValue(chainSettings.peakQuality);
+    peakGainSmoother.setCurrentAndTargetValue(chainSettings.peakGainInDecibels);
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>("LowCut Freq",
-                                                           "LowCut Freq",
-                                                           juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.6f),
-                                                           20.f));
+    for (size_t i = 0; i < (size_t) numExtraBands; ++i)
+    {
+        bandFreqSmoothers[i].setCurrentAndTargetValue(chainSettings.bands.freq[i]);
+        bandQualitySmoothers[i].setCurrentAndTargetValue(chainSettings.bands.quality[i]);
+        bandGainSmoothers[i].setCurrentAndTargetValue(chainSettings.bands.gainInDecibels[i]);
+    }
+}
+
+template <typename SampleType>
+void NormalEQAudioProcessor::processSmoothed(juce::dsp::AudioBlock<SampleType>& block, int controlInterval)
+{
+    // 스무딩 경로는 직접 설계하므로 배율도 파라미터에서 바로 가져옴
+    // 배율이 바뀌면 이전 계수에서 보간할 수 없으므로 모든 밴드를 즉시 다시 설계
+    const auto previousOversamplingIndex = oversamplingIndex;
+    updateOversampling<SampleType>(static_cast<int>(parameterHandles.get(Parameter_Oversampling)), oversamplingQuality);
+    const auto stereoModeChanged = updateStereoMode<SampleType>(parameterHandles.get(Parameter_StereoMode) > 0.5f);
+    const auto oversamplingChanged = oversamplingIndex != previousOversamplingIndex
+                                  || stereoModeChanged
+                                  || std::exchange(redesignImmediately, false);
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>("HighCut Freq",
-                                                           "HighCut Freq",
-                                                           juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.6f),
-                                                           20000.f));
+    if (oversamplingChanged)
+        for (auto& changed : bandChanged)
+            changed.set(true);
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Freq",
-                                                           "Peak Freq",
-                                                           juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.3f),
-                                                           1000.f));
+    // 기울기, 밴드 종류 변경은 스무딩 대상이 아니므로 첫 구간에서 한 번만 반영
+    std::array<bool, numBands> needsUpdate;
+    auto anyChanged = false;
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Gain",
-                                                           "Peak Gain",
-                                                           juce::NormalisableRange<float>(-24.f, 24.f, 0.1f, 0.2f),
-                                                           0.0f));
+    for (size_t band = 0; band < (size_t) numBands; ++band)
+    {
+        needsUpdate[band] = bandChanged[band].compareAndSetBool(false, true);
+        anyChanged = anyChanged || needsUpdate[band];
+    }
     
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Quality",
-                                                           "Peak Quality",
-                                                           juce::NormalisableRange<float>(0.1f, 10.f, 0.01f, 0.3f),
-                                                           1.f));
+    // 변경이 있으면 스무더의 목표값만 바꾸고 실제 설계는 컨트롤 레이트로 나눠서 진행
+    if (anyChanged)
+    {
+        targetSettings = getChainSettings(parameterHandles, controlOverrides);
+        lowCutFreqSmoother.setTargetValue(targetSettings.lowCutFreq);
+        highCutFreqSmoother.setTargetValue(targetSettings.highCutFreq);
+        peakFreqSmoother.setTargetValue(targetSettings.peakFreq);
+        peakQualitySmoother.setTargetValue(targetSettings.peakQuality);
+        peakGainSmoother.setTargetValue(targetSettings.peakGainInDecibels);
+        
+        for (size_t i = 0; i < (size_t) numExtraBands; ++i)
+        {
+            bandFreqSmoothers[i].setTargetValue(targetSettings.bands.freq[i]);
+            bandQualitySmoothers[i].setTargetValue(targetSettings.bands.quality[i]);
+            bandGainSmoothers[i].setTargetValue(targetSettings.bands.gainInDecibels[i]);
+        }
+    }
+    
+    const auto numSamples = static_cast<int>(block.getNumSamples());
     
-    juce::StringArray stringArray;
-    for(int i = 0; i < 4; ++i)
+    for (int start = 0; start < numSamples; start += controlInterval)
     {
-        juce::String str;
-        str << (12 + i * 12);
-        stringArray.add(str);
+        const auto length = juce::jmin(controlInterval, numSamples - start);
+        
+        std::array<bool, numBands> moving;
+        moving[ChainPosition::LowCut] = needsUpdate[ChainPosition::LowCut] || lowCutFreqSmoother.isSmoothing();
+        moving[ChainPosition::Peak] = needsUpdate[ChainPosition::Peak]
+                                   || peakFreqSmoother.isSmoothing()
+                                   || peakQualitySmoother.isSmoothing()
+                                   || peakGainSmoother.isSmoothing();
+        moving[ChainPosition::HighCut] = needsUpdate[ChainPosition::HighCut] || highCutFreqSmoother.isSmoothing();
+        
+        for (size_t i = 0; i < (size_t) numExtraBands; ++i)
+            moving[firstExtraBand + i] = needsUpdate[firstExtraBand + i]
+                                      || bandFreqSmoothers[i].isSmoothing()
+                                      || bandQualitySmoothers[i].isSmoothing()
+                                      || bandGainSmoothers[i].isSmoothing();
+        
+        if (std::find(moving.begin(), moving.end(), true) != moving.end())
+        {
+            // 구간 끝의 스무딩된 값으로 설계하고 구간 길이에 걸쳐 보간
+            auto settings = targetSettings;
+            settings.lowCutFreq = lowCutFreqSmoother.skip(length);
+            settings.highCutFreq = highCutFreqSmoother.skip(length);
+            settings.peakFreq = peakFreqSmoother.skip(length);
+            settings.peakQuality = peakQualitySmoother.skip(length);
+            settings.peakGainInDecibels = peakGainSmoother.skip(length);
+            
+            for (size_t i = 0; i < (size_t) numExtraBands; ++i)
+            {
+                settings.bands.freq[i] = bandFreqSmoothers[i].skip(length);
+                settings.bands.quality[i] = bandQualitySmoothers[i].skip(length);
+                settings.bands.gainInDecibels[i] = bandGainSmoothers[i].skip(length);
+            }
+            
+            // 엔진은 오버샘플링된 레이트에서 돌기 때문에 보간 길이도 배율만큼 늘림
+            const auto rampLength = oversamplingChanged ? 0 : length << oversamplingIndex;
+            
+            if (moving[ChainPosition::LowCut])
+                updateLowCutFilters<SampleType>(settings, rampLength);
+            if (moving[ChainPosition::Peak])
+                updatePeakFilter<SampleType>(settings, rampLength);
+            if (moving[ChainPosition::HighCut])
+                updateHighCutFilters<SampleType>(settings, rampLength);
+            
+            for (int i = 0; i < numExtraBands; ++i)
+                if (moving[(size_t) (firstExtraBand + i)])
+                    updateBandFilter<SampleType>(settings, i, rampLength);
+            
+            needsUpdate.fill(false);
+            performanceCounters.addRedesign();
+        }
+        
+        auto subBlock = block.getSubBlock((size_t) start, (size_t) length);
+        getState<SampleType>().process(subBlock);
     }
+}
+
+void NormalEQAudioProcessor::markAllBandsChanged()
+{
+    for (auto& changed : bandChanged)
+        changed.set(true);
     
-    layout.add(std::make_unique<juce::AudioParameterChoice>("LowCut Slope",
-                                                            "LowCut Slope",
-                                                            stringArray,
-                                                            0));
+    coefficientDesigner.markAllChanged();
+}
+
+void NormalEQAudioProcessor::parameterValueChanged(int parameterIndex, float newValue)
+{
+    // 호스트 자동화의 경우 오디오 스레드에서도 불릴 수 있으므로 플래그만 세움
+    if (! juce::isPositiveAndBelow(parameterIndex, (int) parameterBands.size()))
+        return;
     
-    layout.add(std::make_unique<juce::AudioParameterChoice>("HighCut Slope",
-                                                            "HighCut Slope",
-                                                            stringArray,
-                                                            0));
+    if (const auto band = parameterBands[(size_t) parameterIndex])
+    {
+        bandChanged[(size_t) *band].set(true);
+        coefficientDesigner.markChanged(*band);
+    }
+    else
+    {
+        markAllBandsChanged();
+    }
+}
+
+//==============================================================================
+CoefficientDesigner::CoefficientDesigner(const ParameterHandles& parametersToUse)
+    : juce::Thread("normalEQ Coefficient Designer"), parameters(parametersToUse)
+{
+}
+
+CoefficientDesigner::~CoefficientDesigner()
+{
+    stopThread(1000);
+}
+
+void CoefficientDesigner::prepare(double sampleRate)
+{
+    {
+        const juce::ScopedLock sl(designLock);
+        baseSampleRate = sampleRate;
+        
+        for (auto& changed : bandChanged)
+            changed.set(true);
+        
+        designChangedBands();
+    }
     
+    // 이미 돌고 있으면 아무것도 하지 않음
+    startThread();
+}
+
+void CoefficientDesigner::markChanged(int band)
+{
+    bandChanged[(size_t) band].set(true);
+    changeSerial.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void CoefficientDesigner::markAllChanged()
+{
+    for (auto& changed : bandChanged)
+        changed.set(true);
     
-    return layout;
+    changeSerial.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void CoefficientDesigner::run()
+{
+    auto pollIntervalMs = minPollIntervalMs;
+    
+    while (! threadShouldExit())
+    {
+        // notify 는 이벤트의 mutex 를 잡으므로 오디오 스레드에서 부를 수 없음, 대신 주기적으로 확인
+        // stopThread 는 이 대기를 바로 깨움
+        wait(pollIntervalMs);
+        
+        if (threadShouldExit())
+            break;
+        
+        // 오프라인 렌더 중에는 처리 스레드가 직접 설계함
+        if (offline.load())
+            continue;
+        
+        // 쉬는 동안은 깨어나는 횟수를 줄이고, 변경이 들어오면 드래그나 오토메이션 동안은 다시 minPollIntervalMs 마다 확인
+        // 쉬다가 처음 들어온 변경은 최대 maxPollIntervalMs 늦게 설계됨
+        pollIntervalMs = designPendingChanges() ? minPollIntervalMs
+                                                : juce::jmin(pollIntervalMs * 2, maxPollIntervalMs);
+    }
+}
+
+bool CoefficientDesigner::designPendingChanges()
+{
+    // 변경이 없으면 잠금도 잡지 않음
+    if (changeSerial.load(std::memory_order_acquire) == designedSerial.load(std::memory_order_acquire))
+        return false;
+    
+    const juce::ScopedLock sl(designLock);
+    designChangedBands();
+    return true;
+}
+
+void CoefficientDesigner::designChangedBands()
+{
+    if (baseSampleRate <= 0.0)
+        return;
+    
+    // 변경 번호는 플래그보다 먼저 읽음, 이 번호까지의 변경은 아래에서 읽는 파라미터 값에 들어 있음
+    const auto serial = changeSerial.load(std::memory_order_acquire);
+    designedSerial.store(serial, std::memory_order_release);
+    
+    // 플래그를 먼저 내리고 설정을 읽어야 그 사이에 들어온 변경을 놓치지 않음
+    std::array<bool, numBands> changed;
+    
+    for (size_t band = 0; band < (size_t) numBands; ++band)
+        changed[band] = bandChanged[band].compareAndSetBool(false, true);
+    
+    // 오버샘플링 배율이 바뀌면 설계 샘플 레이트가 달라지므로 모든 밴드를 다시 설계
+    const auto oversamplingIndex = static_cast<int>(parameters.get(Parameter_Oversampling));
+    const auto sampleRate = baseSampleRate * (1 << oversamplingIndex);
+    
+    if (sampleRate != current.sampleRate)
+    {
+        current.sampleRate = sampleRate;
+        current.oversamplingIndex = oversamplingIndex;
+        changed.fill(true);
+    }
+    
+    // 모드가 바뀌면 엔진 상태가 초기화되므로 모든 밴드를 다시 넣도록 함
+    const auto midSide = parameters.get(Parameter_StereoMode) > 0.5f;
+    
+    if (midSide != current.midSide)
+    {
+        current.midSide = midSide;
+        changed.fill(true);
+    }
+    
+    if (std::find(changed.begin(), changed.end(), true) == changed.end())
+        return;
+    
+    const auto chainSettings = getChainSettings(parameters);
+    auto& settings = current.settings;
+    
+    // 변경된 밴드의 설정과 계수만 갱신, 나머지는 이전 스냅샷 그대로
+    if (changed[ChainPosition::LowCut])
+    {
+        settings.lowCutFreq = chainSettings.lowCutFreq;
+        settings.lowCutSlope = chainSettings.lowCutSlope;
+        settings.lowCutPlacement = chainSettings.lowCutPlacement;
+        
+        current.numLowCutSections = designLowCutSections(settings, current.sampleRate, current.lowCut);
+        designLowCutSections(settings, current.sampleRate, current.svfLowCut);
+    }
+    
+    if (changed[ChainPosition::Peak])
+    {
+        settings.peakFreq = chainSettings.peakFreq;
+        settings.peakGainInDecibels = chainSettings.peakGainInDecibels;
+        settings.peakQuality = chainSettings.peakQuality;
+        settings.peakPlacement = chainSettings.peakPlacement;
+        
+        current.peak = designPeakSection(settings, current.sampleRate);
+        current.svfPeak = designPeakSVFSection(settings, current.sampleRate);
+    }
+    
+    if (changed[ChainPosition::HighCut])
+    {
+        settings.highCutFreq = chainSettings.highCutFreq;
+        settings.highCutSlope = chainSettings.highCutSlope;
+        settings.highCutPlacement = chainSettings.highCutPlacement;
+        
+        current.numHighCutSections = designHighCutSections(settings, current.sampleRate, current.highCut);
+        designHighCutSections(settings, current.sampleRate, current.svfHighCut);
+    }
+    
+    for (int i = 0; i < numExtraBands; ++i)
+    {
+        if (! changed[(size_t) (firstExtraBand + i)])
+            continue;
+        
+        const auto b = (size_t) i;
+        settings.bands.type[b] = chainSettings.bands.type[b];
+        settings.bands.freq[b] = chainSettings.bands.freq[b];
+        settings.bands.gainInDecibels[b] = chainSettings.bands.gainInDecibels[b];
+        settings.bands.quality[b] = chainSettings.bands.quality[b];
+        settings.bands.placement[b] = chainSettings.bands.placement[b];
+        
+        current.bands[b] = designBandSection(settings, i, current.sampleRate);
+        current.svfBands[b] = designBandSVFSection(settings, i, current.sampleRate);
+    }
+    
+    current.tailSeconds = current.computeTailSeconds();
+    tailSeconds.store(current.tailSeconds);
+    
+    ++current.version;
+    current.changeSerial = serial;
+    
+    snapshots.getWriteBuffer() = current;
+    snapshots.publish();
+    
+    // 에디터는 설계를 다시 하지 않고 같은 계수로 응답 곡선을 그림
+    editorSnapshots.getWriteBuffer() = current;
+    editorSnapshots.publish();
+    
+    if (onSnapshotDesigned != nullptr)
+        onSnapshotDesigned(current);
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout NormalEQAudioProcessor::createParameterLayout()
+{
+    // AudioProcessorParameter Diagram 참고
+    // 범위, 기본값, 선택지는 모두 ParameterRegistry.h 의 표에 있음
+    return createParameterLayoutFromRegistry();
 }
 
 
@@ -9,6 +9,16 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <optional>
+#include "SIMDFilterEngine.h"
+#include "SVFFilter.h"
+#include "BiquadDesign.h"
+#include "TripleBuffer.h"
+#include "LinearPhaseEQ.h"
+#include "PerformanceCounters.h"
+#include "SpectrumAnalyzer.h"
+#include "PresetLibrary.h"
+#include "ParameterRegistry.h"
 
 // 기울기를 설정하기 위한 열거형 선언
 enum Slope
@@ -20,6 +30,32 @@ enum Slope
 };
 
 
+// 로우컷, 피크, 하이컷 뒤에 오는 추가 밴드의 종류
+enum BandType
+{
+    BandType_Off,
+    BandType_Peak,
+    BandType_LowShelf,
+    BandType_HighShelf,
+    BandType_Notch
+};
+
+// Mid/Side 모드에서 밴드가 처리하는 신호, Stereo 모드에서는 항상 양쪽
+enum Placement
+{
+    Placement_Stereo,
+    Placement_Mid,
+    Placement_Side
+};
+
+// 추가 밴드의 설정, 밴드마다 객체를 두지 않고 값 종류별로 미리 잡아 둔 배열 (SoA)
+struct BandPoolSettings
+{
+    std::array<BandType, numExtraBands> type {};
+    std::array<float, numExtraBands> freq {}, gainInDecibels {}, quality {};
+    std::array<Placement, numExtraBands> placement {};
+};
+
 // 체인 계수를 설정하기 위한 struct
 struct ChainSettings
 {
@@ -27,10 +63,26 @@ struct ChainSettings
     float lowCutFreq{0}, highCutFreq{0};
     
     Slope lowCutSlope {Slope::Slope_12}, highCutSlope {Slope::Slope_12};
+    
+    Placement lowCutPlacement {Placement_Stereo}, peakPlacement {Placement_Stereo}, highCutPlacement {Placement_Stereo};
+    
+    BandPoolSettings bands;
 };
-using Filter = juce::dsp::IIR::Filter<float>;
-using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
+
+// float, double 처리 경로가 같은 코드를 쓰도록 샘플 타입으로 템플릿화
+template <typename SampleType>
+using FilterType = juce::dsp::IIR::Filter<SampleType>;
+
+template <typename SampleType>
+using CutFilterType = juce::dsp::ProcessorChain<FilterType<SampleType>, FilterType<SampleType>,
+                                                FilterType<SampleType>, FilterType<SampleType>>;
+
+template <typename SampleType>
+using MonoChainType = juce::dsp::ProcessorChain<CutFilterType<SampleType>, FilterType<SampleType>, CutFilterType<SampleType>>;
+
+using Filter = FilterType<float>;
+using CutFilter = CutFilterType<float>;
+using MonoChain = MonoChainType<float>;
 
 enum ChainPosition
 {
@@ -39,13 +91,47 @@ enum ChainPosition
     HighCut
 };
 
-using Coefficients = Filter::CoefficientsPtr;
+template <typename SampleType>
+using CoefficientsType = typename FilterType<SampleType>::CoefficientsPtr;
 
-void updateCoefficients(Coefficients& old, const Coefficients& replacements);
+using Coefficients = CoefficientsType<float>;
 
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate);
+template <typename SampleType>
+void updateCoefficients(CoefficientsType<SampleType>& old, const CoefficientsType<SampleType>& replacements)
+{
+    //
+    *old = *replacements;
+}
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
+template <typename SampleType = float>
+CoefficientsType<SampleType> makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::IIR::Coefficients<SampleType>::makePeakFilter(sampleRate,
+                                                                    static_cast<SampleType>(chainSettings.peakFreq),
+                                                                    static_cast<SampleType>(chainSettings.peakQuality),
+                                                                    juce::Decibels::decibelsToGain(static_cast<SampleType>(chainSettings.peakGainInDecibels)));
+}
+
+// 오디오 스레드가 MIDI CC 로 먼저 바꾼 값 (정규화되지 않은 실제 값)
+// 메시지 스레드가 파라미터에 반영할 때까지 파라미터 값 대신 쓰임
+struct ParameterOverrides
+{
+    std::array<float, numParameters> values {};
+    std::array<bool, numParameters> active {};
+    
+    float get(const ParameterHandles& parameters, ParameterIndex parameter) const noexcept
+    {
+        return active[(size_t) parameter] ? values[(size_t) parameter] : parameters.get(parameter);
+    }
+};
+
+// 미리 찾아 둔 핸들로 읽으므로 오디오 스레드에서 불러도 됨
+ChainSettings getChainSettings(const ParameterHandles& parameters);
+ChainSettings getChainSettings(const ParameterHandles& parameters, const ParameterOverrides& overrides);
+
+// 파라미터 ID로부터 그 파라미터가 속한 밴드 번호를 찾음
+// 스무딩, 오버샘플링처럼 특정 밴드에 속하지 않는 파라미터는 모든 밴드에 영향을 주므로 nullopt
+std::optional<int> getBandIndex(const juce::String& parameterID);
 
 template<int Index, typename ChainType, typename CoefficientType>
 void update(ChainType& chain, const CoefficientType& Coefficients)
@@ -88,24 +174,229 @@ void updateCutFilter(ChainType& chain,
 
 
 
+// 버터워스 차수, 바이쿼드와 SVF 설계가 같은 값을 씀
+inline int getLowCutOrder(const ChainSettings& chainSettings) { return 2 * (chainSettings.lowCutSlope) + 1; }
+inline int getHighCutOrder(const ChainSettings& chainSettings) { return 2 * (chainSettings.highCutSlope + 1); }
+
+template <typename SampleType = float>
 inline auto makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate)
 {
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq, sampleRate,2 * (chainSettings.lowCutSlope) + 1);
+    return juce::dsp::FilterDesign<SampleType>::designIIRHighpassHighOrderButterworthMethod(static_cast<SampleType>(chainSettings.lowCutFreq), sampleRate, getLowCutOrder(chainSettings));
 }
 
+template <typename SampleType = float>
 inline auto makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate)
 {
-    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq, sampleRate, 2 * (chainSettings.highCutSlope + 1));
+    return juce::dsp::FilterDesign<SampleType>::designIIRLowpassHighOrderButterworthMethod(static_cast<SampleType>(chainSettings.highCutFreq), sampleRate, getHighCutOrder(chainSettings));
 }
 
+// 소리에 영향을 주지 않는 설정의 밴드는 엔진에서 아예 빠짐
+// 로우컷 20 Hz, 하이컷 20 kHz 는 파라미터 범위의 끝이므로 꺼진 것으로 취급
+bool isLowCutNeutral(const ChainSettings& chainSettings);
+bool isHighCutNeutral(const ChainSettings& chainSettings);
+bool isPeakNeutral(const ChainSettings& chainSettings);
+bool isBandNeutral(const ChainSettings& chainSettings, int extraBand);
+
+// 밴드별 설계를 double 로 수행, 중립인 밴드는 섹션 0 개(피크는 항등 계수)
+// 설계 스레드와 스무딩 경로가 같은 규칙을 쓰도록 한 곳에 모음
+// BiquadDesign.h 의 함수로 호출한 쪽의 배열에 바로 쓰므로 할당이 없음 (오디오 스레드에서 불러도 됨)
+int designLowCutSections(const ChainSettings& chainSettings, double sampleRate,
+                         std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections>& sections);
+int designHighCutSections(const ChainSettings& chainSettings, double sampleRate,
+                          std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections>& sections);
+BiquadCoefficients<double> designPeakSection(const ChainSettings& chainSettings, double sampleRate);
+
+// SVF 엔진용, 같은 응답을 g, k 형태로 닫힌 식에서 바로 계산
+int designLowCutSections(const ChainSettings& chainSettings, double sampleRate,
+                         std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections>& sections);
+int designHighCutSections(const ChainSettings& chainSettings, double sampleRate,
+                          std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections>& sections);
+SVFCoefficients<double> designPeakSVFSection(const ChainSettings& chainSettings, double sampleRate);
+
+// 추가 밴드 하나 (extraBand 는 0 부터), 꺼져 있거나 중립이면 항등 섹션
+BiquadCoefficients<double> designBandSection(const ChainSettings& chainSettings, int extraBand, double sampleRate);
+SVFCoefficients<double> designBandSVFSection(const ChainSettings& chainSettings, int extraBand, double sampleRate);
+
+// 설계가 끝난 계수 한 벌, 발행된 뒤에는 바뀌지 않음
+// 낮은 컷오프에서의 정밀도를 위해 항상 double 로 설계하고 엔진에 넣을 때 샘플 타입으로 변환
+struct CoefficientSnapshot
+{
+    ChainSettings settings;
+    
+    // sampleRate 는 설계에 쓰인 (오버샘플링된) 샘플 레이트
+    double sampleRate = 0.0;
+    int oversamplingIndex = 0;
+    
+    // Stereo Mode 파라미터, 밴드의 Placement 는 settings 에 있음
+    bool midSide = false;
+    
+    std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> lowCut, highCut;
+    int numLowCutSections = 0, numHighCutSections = 0;
+    BiquadCoefficients<double> peak;
+    
+    // 같은 설정을 SVF 엔진 형태로 설계한 것, 섹션 수는 위와 같음
+    std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> svfLowCut, svfHighCut;
+    SVFCoefficients<double> svfPeak;
+    
+    // 추가 밴드, 꺼진 밴드는 항등 섹션
+    std::array<BiquadCoefficients<double>, numExtraBands> bands;
+    std::array<SVFCoefficients<double>, numExtraBands> svfBands;
+    
+    // 모든 활성 섹션의 임펄스 응답이 -120 dB 아래로 줄어드는 시간
+    double tailSeconds = 0.0;
+    
+    juce::uint32 version = 0;
+    
+    // 설계를 시작할 때의 CoefficientDesigner 변경 번호, 이 번호까지의 파라미터 변경이 반영되어 있음
+    juce::uint32 changeSerial = 0;
+    
+    // Placement 가 적용되는 레인, Stereo Mode 가 L/R 이면 모든 레인
+    juce::uint32 getLaneMask(Placement placement) const noexcept
+    {
+        using Engine = SIMDFilterEngine<double>;
+        
+        if (! midSide || placement == Placement_Stereo)
+            return Engine::allLanes;
+        
+        return placement == Placement_Mid ? Engine::midLane : Engine::sideLane;
+    }
+    
+    // 활성 섹션을 로우컷 -> 피크 -> 하이컷 -> 추가 밴드 순서로 모으고 개수를 반환
+    // lanes 를 주면 그 레인에 걸리는 섹션만 모음 (Mid/Side 에서 Mid 또는 Side 하나의 응답)
+    int getActiveSections(std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxSections>& sections,
+                          juce::uint32 lanes = SIMDFilterEngine<double>::allLanes) const
+    {
+        auto appliesTo = [&](Placement placement) { return (getLaneMask(placement) & lanes) != 0; };
+        int numSections = 0;
+        
+        if (appliesTo(settings.lowCutPlacement))
+            for (int i = 0; i < numLowCutSections; ++i)
+                sections[(size_t) numSections++] = lowCut[(size_t) i];
+        
+        if (appliesTo(settings.peakPlacement))
+            sections[(size_t) numSections++] = peak;
+        
+        if (appliesTo(settings.highCutPlacement))
+            for (int i = 0; i < numHighCutSections; ++i)
+                sections[(size_t) numSections++] = highCut[(size_t) i];
+        
+        for (size_t b = 0; b < bands.size(); ++b)
+            if (! isIdentity(bands[b]) && appliesTo(settings.bands.placement[b]))
+                sections[(size_t) numSections++] = bands[b];
+        
+        return numSections;
+    }
+    
+    // 섹션마다의 감쇠 시간을 더한 보수적인 값
+    // Mid/Side 에서는 레인마다 지나는 섹션이 다르고 출력은 두 레인의 합이므로 긴 쪽
+    double computeTailSeconds() const
+    {
+        using Engine = SIMDFilterEngine<double>;
+        
+        if (midSide)
+            return juce::jmax(computeTailSeconds(Engine::midLane), computeTailSeconds(Engine::sideLane));
+        
+        return computeTailSeconds(Engine::allLanes);
+    }
+    
+    double computeTailSeconds(juce::uint32 lanes) const
+    {
+        std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxSections> sections;
+        const auto numSections = getActiveSections(sections, lanes);
+        
+        auto tailSamples = 0.0;
+        for (int i = 0; i < numSections; ++i)
+            tailSamples += getDecaySamples(sections[(size_t) i], juce::Decibels::decibelsToGain(-120.0));
+        
+        return sampleRate > 0.0 ? tailSamples / sampleRate : 0.0;
+    }
+};
+
+// 필터 설계를 오디오 스레드 밖의 백그라운드 스레드에서 수행하고
+// 완성된 스냅샷을 트리플 버퍼로 넘겨준다. 오디오 스레드는 블록마다 인덱스 교환만 한다
+class CoefficientDesigner : private juce::Thread
+{
+public:
+    explicit CoefficientDesigner(const ParameterHandles& parameters);
+    ~CoefficientDesigner() override;
+    
+    // prepareToPlay 에서 호출, 모든 밴드를 바로 설계해서 발행하고 스레드를 시작
+    void prepare(double sampleRate);
+    
+    // 오프라인 렌더 중에는 설계 스레드가 쉬고 처리 스레드가 designPendingChanges 로 직접 설계함
+    // 스냅샷이 도착하는 블록이 스레드 타이밍에 따라 달라지지 않으므로 렌더 결과가 매번 같음
+    void setOffline(bool shouldDesignOnCallingThread) noexcept { offline.store(shouldDesignOnCallingThread); }
+    
+    // 변경된 밴드가 있으면 호출한 스레드에서 바로 설계해서 발행, 설계했으면 true
+    // designLock 을 잡으므로 오디오 스레드에서는 오프라인 렌더 중에만 호출
+    bool designPendingChanges();
+    
+    // 어느 스레드에서든 호출 가능 (오디오 스레드 포함), atomic 플래그와 변경 번호만 바꿈
+    // 잠금이 있는 이벤트를 쓰지 않고 설계 스레드가 주기적으로 변경 번호를 확인함 (run 참고)
+    void markChanged(int band);
+    void markAllChanged();
+    
+    // 오디오 스레드 전용, 새로 발행된 스냅샷이 없으면 nullptr
+    const CoefficientSnapshot* acquireLatest() noexcept { return snapshots.acquire(); }
+    
+    // 메시지 스레드 전용, 에디터용으로 따로 발행된 가장 최근 스냅샷 (아직 설계 전이면 version 0)
+    // 에디터가 여러 개여도 모두 메시지 스레드에서 읽으므로 읽는 쪽은 하나로 취급할 수 있음
+    const CoefficientSnapshot& getEditorSnapshot() noexcept
+    {
+        editorSnapshots.acquire();
+        return editorSnapshots.getReadBuffer();
+    }
+    
+    // markChanged 가 불릴 때마다 증가, 이 값 이후에 발행되는 스냅샷의 changeSerial 은 이 값 이상
+    juce::uint32 getChangeSerial() const noexcept { return changeSerial.load(std::memory_order_acquire); }
+    
+    // 마지막으로 발행한 스냅샷의 꼬리 길이, 어느 스레드에서든 읽을 수 있음
+    double getTailSeconds() const noexcept { return tailSeconds.load(); }
+    
+    // 스냅샷을 발행한 직후 설계 스레드에서 호출됨 (선형 위상 커널 생성 등)
+    std::function<void(const CoefficientSnapshot&)> onSnapshotDesigned;
+    
+private:
+    void run() override;
+    
+    // designLock 을 잡은 상태에서 호출, 변경된 밴드만 다시 설계해서 발행
+    void designChangedBands();
+    
+    const ParameterHandles& parameters;
+    double baseSampleRate = 0.0;
+    
+    // 설계 스레드와 prepare 사이의 직렬화용, 오디오 스레드는 절대 잡지 않음
+    juce::CriticalSection designLock;
+    CoefficientSnapshot current;
+    TripleBuffer<CoefficientSnapshot> snapshots, editorSnapshots;
+    std::array<juce::Atomic<bool>, numBands> bandChanged;
+    std::atomic<double> tailSeconds { 0.0 };
+    std::atomic<juce::uint32> changeSerial { 0 };
+    
+    // 마지막 설계가 반영한 변경 번호, 설계 스레드가 잠금 없이 비교함
+    std::atomic<juce::uint32> designedSerial { 0 };
+    
+    // 변경이 없는 동안은 확인 간격을 두 배씩 늘리고 변경이 있으면 다시 가장 짧게
+    static constexpr int minPollIntervalMs = 5, maxPollIntervalMs = 40;
+    
+    std::atomic<bool> offline { false };
+    
+    JUCE_DECLARE_NON_COPYABLE (CoefficientDesigner)
+};
+
 //==============================================================================
 /**
 */
-class NormalEQAudioProcessor  : public juce::AudioProcessor
+class NormalEQAudioProcessor  : public juce::AudioProcessor,
+                                public juce::AudioProcessorParameter::Listener,
+                                private juce::Timer
 {
 public:
     //==============================================================================
     NormalEQAudioProcessor();
+    
+    // 일괄 처리 도구처럼 사용자 프리셋 라이브러리에 영향을 받지 않아야 할 때는 false
+    explicit NormalEQAudioProcessor(bool shouldLoadUserPresetLibrary);
     ~NormalEQAudioProcessor() override;
 
     //==============================================================================
@@ -117,6 +408,13 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    
+    // 오프라인 렌더에서는 설계 스레드 대신 processBlock 에서 설계함
+    void setNonRealtime (bool isNonRealtime) noexcept override;
+    
+    // 호스트가 double 버퍼를 주면 변환 없이 double 엔진으로 처리
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -145,20 +443,264 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState apvts = {*this, nullptr, "Parameters", createParameterLayout()};
     
+    // 파라미터 표의 값 핸들, apvts 가 만들어진 직후 한 번만 찾음
+    const ParameterHandles& getParameterHandles() const noexcept { return parameterHandles; }
+    
+    // 파라미터가 바뀌면 해당 파라미터가 속한 밴드만 변경됨으로 표시
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override { }
+    
+    // 에디터의 응답 곡선이 읽음, 오디오 스레드가 쓰는 것과 같은 설계 결과 (메시지 스레드 전용)
+    const CoefficientSnapshot& getEditorSnapshot() noexcept { return coefficientDesigner.getEditorSnapshot(); }
     
+    // 에디터의 성능 오버레이가 읽음
+    const PerformanceCounters& getPerformanceCounters() const noexcept { return performanceCounters; }
+    
+    // 에디터가 EQ 전후의 스펙트럼을 그릴 때 씀, 에디터가 여러 개여도 분석은 한 번만 함
+    SpectrumAnalyzer& getSpectrumAnalyzer() noexcept { return spectrumAnalyzer; }
+    
+    // 프리셋 라이브러리를 열고 라이브러리의 파라미터 키를 이 플러그인의 파라미터에 연결
+    // 열리면 호스트의 프로그램 목록이 라이브러리의 프리셋이 됨 (메시지 스레드 전용)
+    bool loadPresetLibrary(const juce::File& file);
+    static juce::File getDefaultPresetLibraryFile();
+
 
 private:
 
-    MonoChain leftChain, rightChain;
+    // 오버샘플링 (2x/4x/8x, 폴리페이즈 하프밴드 IIR 또는 FIR)
+    // 모든 배율과 품질 조합을 prepareToPlay 에서 미리 만들어 두고 오디오 스레드에서는 고르기만 함
+    // 배율은 적용된 스냅샷을 따라가므로 계수와 처리 샘플 레이트가 어긋나지 않음
+    static constexpr int numOversamplingFactors = 3;
     
-    void updatePeakFilter(const ChainSettings& chainSettings);
+    // 샘플 타입(float, double)마다 한 벌씩 있는 처리 상태
+    // prepareToPlay 에서는 호스트가 고른 정밀도 쪽만 준비하므로 다른 쪽은 메모리를 쓰지 않음
+    template <typename SampleType>
+    struct ProcessingState
+    {
+        // 모든 채널을 SIMD 레인에 나눠 담아 처리, 계수는 한 벌만 보관
+        SIMDFilterEngine<SampleType> filterEngine;
+        
+        // 매 샘플 계수를 바꿔도 안전한 TPT 상태 변수 필터, Filter Structure 파라미터로 선택
+        SVFFilterEngine<SampleType> svfEngine;
+        bool useSVF = false;
+        
+        std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, numOversamplingFactors * 2> oversamplers;
+        juce::dsp::Oversampling<SampleType>* activeOversampler = nullptr;
+        
+        void prepare(int numChannels, int samplesPerBlock, double sampleRate);
+        
+        // index 가 0 이면 오버샘플링 없음, 고른 오버샘플러와 엔진 상태를 초기화
+        void selectOversampler(int index, int quality);
+        
+        int getOversamplerLatency() const;
+        
+        int getNumActiveSections() const noexcept
+        {
+            return useSVF ? svfEngine.getNumActiveSections() : filterEngine.getNumActiveSections();
+        }
+        
+        // 오버샘플링이 켜져 있으면 올린 뒤 엔진을 거쳐 다시 내림
+        void process(juce::dsp::AudioBlock<SampleType>& block);
+        
+        template <typename EngineType>
+        void processWith(EngineType& engine, juce::dsp::AudioBlock<SampleType>& block);
+    };
+    
+    ProcessingState<float> floatState;
+    ProcessingState<double> doubleState;
+    
+    template <typename SampleType>
+    ProcessingState<SampleType>& getState() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleState;
+        else
+            return floatState;
+    }
+    
+    // 설계 스레드가 커널을 로드하므로 coefficientDesigner 보다 먼저 선언 (나중에 파괴)
+    LinearPhaseEQ linearPhaseEQ;
+    
+    // float, double 처리 블록이 모두 이 함수로 들어옴
+    template <typename SampleType>
+    void processBlockImpl(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages);
+    
+    // MIDI CC 사이의 구간 하나를 처리, controlledBands 는 구간 시작에서 CC 로 바뀐 밴드 (처리 후 지워짐)
+    template <typename SampleType>
+    void processSegment(juce::dsp::AudioBlock<SampleType>& block, int smoothingIndex,
+                        std::array<bool, numBands>& controlledBands);
+    
+    template <typename SampleType>
+    void prepareState(int samplesPerBlock);
+    
+    // rampLength > 0 이면 엔진이 그 길이에 걸쳐 새 계수로 보간
+    // 계수는 항상 double 로 설계하고 엔진의 샘플 타입으로 변환
+    template <typename SampleType>
+    void updatePeakFilter(const ChainSettings& chainSettings, int rampLength = 0);
     
     // 계수에 대한 포인터
 
-    void updateLowCutFilters(const ChainSettings& chainSettings);
-    void updateHighCutFilters(const ChainSettings& chainSettings);
+    template <typename SampleType>
+    void updateLowCutFilters(const ChainSettings& chainSettings, int rampLength = 0);
+    template <typename SampleType>
+    void updateHighCutFilters(const ChainSettings& chainSettings, int rampLength = 0);
+    template <typename SampleType>
+    void updateBandFilter(const ChainSettings& chainSettings, int extraBand, int rampLength = 0);
+    template <typename SampleType>
     void updateFilters();
     
+    void markAllBandsChanged();
+    
+    // 설계 스레드가 새 스냅샷을 발행했으면 엔진에 적용, 없으면 아무것도 하지 않음
+    template <typename SampleType>
+    void applyLatestSnapshot();
+    
+    // 설계 스레드와 오디오 스레드가 파라미터를 읽는 핸들, 설계 스레드보다 먼저 만들어져야 함
+    ParameterHandles parameterHandles { apvts };
+    
+    // 설계는 백그라운드 스레드에서, 오디오 스레드는 완성된 스냅샷만 받음
+    CoefficientDesigner coefficientDesigner { parameterHandles };
+    
+    // 스무딩 모드: 컨트롤 레이트(16/32/64 샘플)마다 스무딩된 파라미터로 다시 설계하고
+    // 그 사이는 엔진이 계수를 보간한다
+    // 오디오와 시간이 맞아야 하므로 이 모드의 설계는 오디오 스레드에서 이루어짐
+    template <typename SampleType>
+    void processSmoothed(juce::dsp::AudioBlock<SampleType>& block, int controlInterval);
+    void resetSmoothers(const ChainSettings& chainSettings);
+    
+    // 구조가 바뀌면 스무딩 경로가 보간 없이 모든 밴드를 다시 설계
+    bool redesignImmediately = false;
+    
+    int oversamplingIndex = 0, oversamplingQuality = 0;
+    
+    template <typename SampleType>
+    void updateOversampling(int newIndex, int newQuality);
+    
+    // 선형 위상 모드 (0 = Off, 그 외에는 컨볼루션 분할 크기 선택)
+    int linearPhaseIndex = 0;
+    
+    // Mid/Side 모드 (0 = Stereo, 1 = Mid/Side), 채널이 둘일 때만 적용
+    // 밴드마다 Placement 에 따라 엔진의 Mid 레인, Side 레인, 또는 양쪽에 계수를 넣음
+    bool midSide = false;
+    
+    // 바뀌었으면 두 엔진을 모두 전환 (상태 초기화) 하고 true
+    template <typename SampleType>
+    bool updateStereoMode(bool shouldUseMidSide);
+    
+    juce::uint32 getLaneMask(Placement placement) const noexcept;
+    
+    // 현재 처리 모드(오버샘플링, 선형 위상)에 맞는 지연을 호스트에 바로 보고, prepareToPlay 전용
+    void updateLatency();
+    int computeLatencySamples() const;
+    
+    // 오디오 스레드에서 바뀐 지연은 값만 저장하고 보고는 메시지 스레드에서 (setLatencySamples 는 호스트를 부름)
+    // MIDI CC 로 바뀐 값도 같은 타이머에서 파라미터에 반영
+    // triggerAsyncUpdate 는 메시지를 보내면서 잠금을 잡을 수 있으므로 오디오 스레드는 값만 쓰고 타이머가 읽어 감
+    void reportLatencyAsync();
+    void timerCallback() override;
+    std::atomic<int> pendingLatencySamples { 0 };
+    static constexpr int messageThreadPollHz = 30;
+    double getProcessingSampleRate() const { return getSampleRate() * (1 << oversamplingIndex); }
+    
+    using FrequencySmoother = juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative>;
+    FrequencySmoother lowCutFreqSmoother, highCutFreqSmoother, peakFreqSmoother, peakQualitySmoother;
+    juce::SmoothedValue<float> peakGainSmoother;
+    
+    // 추가 밴드의 스무더도 밴드 수만큼 미리 잡아 둠
+    std::array<FrequencySmoother, numExtraBands> bandFreqSmoothers, bandQualitySmoothers;
+    std::array<juce::SmoothedValue<float>, numExtraBands> bandGainSmoothers;
+    ChainSettings targetSettings;
+    
+    // 입력이 무음이고 필터 꼬리까지 다 빠진 뒤에는 처리를 건너뜀
+    // 다시 소리가 들어오면 남은 상태를 지우고 처리를 이어감
+    template <typename SampleType>
+    static bool isSilent(const juce::dsp::AudioBlock<SampleType>& block);
+    void resetProcessingState();
+    
+    juce::int64 silentSamples = 0;
+    bool processingSuspended = false;
+    
+    // 파라미터 인덱스 -> 밴드, 생성자에서 한 번만 만들어 둠
+    std::vector<std::optional<int>> parameterBands;
+    std::array<juce::Atomic<bool>, numBands> bandChanged;
+    
+    // 블록 처리 시간, 재설계, 빠진 섹션, 디노멀 발생 계측
+    // 내보내기는 카운터를 참조하므로 뒤에 선언 (먼저 파괴)
+    PerformanceCounters performanceCounters;
+    std::unique_ptr<PerformanceExporter> performanceExporter;
+    
+    SpectrumAnalyzer spectrumAnalyzer;
+    
+    // 상태 저장, 프리셋 조회에 쓰는 키 -> 파라미터 표, 키 순서로 정렬해 두고 이진 탐색
+    struct KeyedParameter
+    {
+        juce::uint32 key;
+        juce::RangedAudioParameter* parameter;
+    };
+    
+    std::vector<KeyedParameter> parametersByKey;
+    juce::RangedAudioParameter* findParameter(juce::uint32 key) const noexcept;
+    
+    // 실제 값 (파라미터 범위 기준) 으로 바뀐 파라미터만 설정, 빠진 파라미터는 기본값
+    void applyParameterValues(const std::vector<CompactState::Entry>& entries);
+    
+    PresetLibrary presetLibrary;
+    std::vector<juce::RangedAudioParameter*> presetParameters;   // 라이브러리 파라미터 순서, 없는 키는 nullptr
+    int currentPreset = 0;
+    
+    void recallPreset(int index);
+    
+    // 프리셋을 바꾼 직후 도착하는 스냅샷은 계수를 crossfadeSamples 동안 보간해서 적용
+    // 설계 스레드가 늦게 발행해도 잡을 수 있도록 보간을 받는 구간은 그보다 길게 둠
+    std::atomic<bool> presetRecalled { false };
+    int crossfadeSamples = 0, crossfadeWindowSamples = 0, crossfadeWindowRemaining = 0;
+    
+    // MIDI CC -> 파라미터, 0 ~ 31 번은 +32 번을 LSB 로 받는 14 비트 컨트롤러로도 동작
+    // 블록은 CC 의 타임스탬프에서 나뉘고, 그 샘플부터 오디오 스레드에서 설계한 계수로 처리됨
+    // 앞의 분할점에서 minimumSegmentLength 안쪽의 이벤트는 그 분할점부터 적용되므로 타이밍 오차는 이 값 미만
+    static constexpr int minimumSegmentLength = 16;
+    std::array<std::optional<ParameterIndex>, 128> midiControllerParameters {};
+    std::array<int, 32> midiControllerMSB {};
+    
+    // 매핑된 CC 면 파라미터와 정규화된 값을 돌려줌, 14 비트 컨트롤러의 MSB 도 여기서 기억
+    std::optional<ParameterIndex> getControlledParameter(const juce::MidiMessageMetadata& metadata, float& value) noexcept;
+    
+    // CC 값을 오디오 스레드의 controlOverrides 에 기록하고 메시지 스레드로 보냄, 값이 바뀌었으면 그 밴드를 돌려줌
+    // 파라미터는 메시지 스레드에서만 바꾸므로 리스너와 설계 스레드가 오디오 스레드에서 불리지 않음
+    std::optional<int> setControlledValue(ParameterIndex parameter, float value);
+    
+    // 처리를 건너뛰는 블록에서는 나누지 않고 값만 반영
+    void applyControlChanges(const juce::MidiBuffer& midiMessages);
+    
+    // 오디오 스레드 전용, 메시지 스레드가 보낸 값을 모두 반영했으면 덮어쓴 값을 버림
+    void updateControlOverrides();
+    
+    // 보내지 못한 값 (큐가 가득 찬 경우) 을 다시 보냄
+    void sendControlChanges();
+    
+    ParameterOverrides controlOverrides;
+    std::array<bool, numParameters> unsentControlChanges {};
+    bool controlChangesPending = false;
+    
+    // 오디오 스레드 -> 메시지 스레드 (파라미터, 정규화된 값) 단일 생산자, 단일 소비자 큐
+    struct ControlChange
+    {
+        ParameterIndex parameter;
+        float value;
+    };
+    
+    static constexpr int controlChangeQueueSize = 256;
+    juce::AbstractFifo controlChangeFifo { controlChangeQueueSize };
+    std::array<ControlChange, controlChangeQueueSize> controlChangeQueue {};
+    
+    // 보낸 개수 (오디오 스레드) 와 메시지 스레드가 파라미터에 반영한 개수, 반영 직후의 변경 번호
+    juce::uint32 sentControlChanges = 0;
+    std::atomic<juce::uint32> appliedControlChanges { 0 };
+    std::atomic<juce::uint32> appliedControlSerial { 0 };
+    
+    // CC 로 오디오 스레드에서 먼저 설계한 뒤에는 그 값이 반영되지 않은 스냅샷을 버림
+    juce::uint32 requiredChangeSerial = 0;
+    
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NormalEQAudioProcessor)
 };
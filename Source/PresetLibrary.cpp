@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.cpp
+    Created: 17 Oct 2026 11:52:06pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#include "PresetLibrary.h"
+
+
+juce::uint32 getParameterKey(const juce::String& parameterID)
+{
+    // FNV-1a, 실행 환경과 상관없이 같은 값이 나와야 하므로 직접 계산
+    juce::uint32 hash = 2166136261u;
+
+    for (auto* c = parameterID.toRawUTF8(); *c != 0; ++c)
+    {
+        hash ^= (juce::uint8) *c;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+//==============================================================================
+void CompactState::write(juce::MemoryBlock& destination, const std::vector<Entry>& entries)
+{
+    juce::MemoryOutputStream mos(destination, false);
+    mos.preallocate(12 + entries.size() * 8);
+
+    mos.writeInt((int) magic);
+    mos.writeInt((int) currentVersion);
+    mos.writeInt((int) entries.size());
+
+    for (const auto& entry : entries)
+    {
+        mos.writeInt((int) entry.key);
+        mos.writeFloat(entry.value);
+    }
+}
+
+bool CompactState::read(const void* data, int sizeInBytes, std::vector<Entry>& entries)
+{
+    if (data == nullptr || sizeInBytes < 12)
+        return false;
+
+    juce::MemoryInputStream mis(data, (size_t) sizeInBytes, false);
+
+    if ((juce::uint32) mis.readInt() != magic)
+        return false;
+
+    // 새 버전의 플러그인이 저장한 상태는 해석하지 않음
+    if ((juce::uint32) mis.readInt() > currentVersion)
+        return false;
+
+    const auto numEntries = mis.readInt();
+
+    if (numEntries < 0 || (juce::int64) numEntries * 8 > mis.getNumBytesRemaining())
+        return false;
+
+    entries.resize((size_t) numEntries);
+
+    for (auto& entry : entries)
+    {
+        entry.key = (juce::uint32) mis.readInt();
+        entry.value = mis.readFloat();
+    }
+
+    return true;
+}
+
+//==============================================================================
+bool PresetLibrary::open(const juce::File& file)
+{
+    close();
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    if (mapped->getData() == nullptr || mapped->getSize() < (size_t) headerSize)
+        return false;
+
+    data = static_cast<const char*>(mapped->getData());
+    dataSize = mapped->getSize();
+
+    const auto fileMagic = readUInt32(0);
+    const auto fileVersion = readUInt32(4);
+    const auto presets = (juce::uint64) readUInt32(8);
+    const auto parameters = (juce::uint64) readUInt32(12);
+
+    // 곱하기 전에 개수부터 제한해서 아래 오프셋 계산이 넘치지 않게 함
+    // 항목마다 최소 4바이트이므로 헤더 뒤 남은 크기의 1/4 을 넘을 수 없고, int 로 보관하므로 INT_MAX 이하
+    const auto maxCount = juce::jmin((juce::uint64) (dataSize - (size_t) headerSize) / 4,
+                                     (juce::uint64) std::numeric_limits<int>::max());
+
+    if (fileMagic != magic || fileVersion > currentVersion || presets > maxCount || parameters > maxCount)
+    {
+        data = nullptr;
+        dataSize = 0;
+        return false;
+    }
+
+    // 표가 파일 크기를 넘지 않는지 먼저 확인해 두면 조회할 때는 검사하지 않아도 됨
+    // 값 표의 크기는 곱하지 않고 나눗셈으로 비교해서 wrap-around 가 생기지 않게 함
+    const auto keys = (juce::uint64) headerSize;
+    const auto nameOffsets = keys + parameters * 4;
+    const auto values = nameOffsets + (presets + 1) * 4;
+
+    if (values > dataSize || (parameters > 0 && presets > (dataSize - values) / (parameters * 4)))
+    {
+        data = nullptr;
+        dataSize = 0;
+        return false;
+    }
+
+    const auto names = values + presets * parameters * 4;
+
+    keysOffset = (size_t) keys;
+    nameOffsetsOffset = (size_t) nameOffsets;
+    valuesOffset = (size_t) values;
+    namesOffset = (size_t) names;
+
+    // 이름 오프셋은 단조 증가하고 파일 안에 있어야 함
+    for (juce::uint64 i = 0; i < presets; ++i)
+    {
+        const auto start = readUInt32(nameOffsetsOffset + (size_t) i * 4);
+        const auto end = readUInt32(nameOffsetsOffset + (size_t) (i + 1) * 4);
+
+        if (start > end || namesOffset + end > dataSize)
+        {
+            data = nullptr;
+            dataSize = 0;
+            return false;
+        }
+    }
+
+    numPresets = (int) presets;
+    numParameters = (int) parameters;
+    mappedFile = std::move(mapped);
+    return true;
+}
+
+void PresetLibrary::close()
+{
+    mappedFile.reset();
+    data = nullptr;
+    dataSize = 0;
+    numPresets = numParameters = 0;
+}
+
+juce::uint32 PresetLibrary::readUInt32(size_t offset) const noexcept
+{
+    return juce::ByteOrder::littleEndianInt(data + offset);
+}
+
+juce::uint32 PresetLibrary::getParameterKey(int parameter) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(parameter, numParameters));
+    return readUInt32(keysOffset + (size_t) parameter * 4);
+}
+
+float PresetLibrary::getValue(int preset, int parameter) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(preset, numPresets) && juce::isPositiveAndBelow(parameter, numParameters));
+
+    const auto bits = readUInt32(valuesOffset + ((size_t) preset * (size_t) numParameters + (size_t) parameter) * 4);
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+juce::String PresetLibrary::getName(int preset) const
+{
+    if (! juce::isPositiveAndBelow(preset, numPresets))
+        return {};
+
+    const auto start = readUInt32(nameOffsetsOffset + (size_t) preset * 4);
+    const auto end = readUInt32(nameOffsetsOffset + (size_t) (preset + 1) * 4);
+
+    return juce::String::fromUTF8(data + namesOffset + start, (int) (end - start));
+}
+
+bool PresetLibrary::write(const juce::File& file, const std::vector<juce::uint32>& keys,
+                          const juce::StringArray& names, const std::vector<float>& values)
+{
+    const auto numKeys = keys.size();
+    const auto numNames = (size_t) names.size();
+
+    if (values.size() != numKeys * numNames)
+    {
+        jassertfalse;
+        return false;
+    }
+
+    juce::MemoryBlock nameBlob;
+    std::vector<juce::uint32> nameOffsets { 0 };
+
+    for (const auto& name : names)
+    {
+        nameBlob.append(name.toRawUTF8(), name.getNumBytesAsUTF8());
+        nameOffsets.push_back((juce::uint32) nameBlob.getSize());
+    }
+
+    juce::MemoryOutputStream mos;
+    mos.writeInt((int) magic);
+    mos.writeInt((int) currentVersion);
+    mos.writeInt((int) numNames);
+    mos.writeInt((int) numKeys);
+
+    for (auto key : keys)
+        mos.writeInt((int) key);
+
+    for (auto offset : nameOffsets)
+        mos.writeInt((int) offset);
+
+    for (auto value : values)
+        mos.writeFloat(value);
+
+    mos.write(nameBlob.getData(), nameBlob.getSize());
+
+    // 열려 있는 맵핑이 쓰다 만 파일을 보지 않도록 임시 파일에 쓴 뒤 교체
+    juce::TemporaryFile temporary(file);
+
+    return temporary.getFile().replaceWithData(mos.getData(), mos.getDataSize())
+        && temporary.overwriteTargetFileWithTemporary();
+}
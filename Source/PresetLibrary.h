@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.h
+    Created: 17 Oct 2026 11:52:06pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+// 상태와 프리셋 파일에서 파라미터 ID 대신 쓰는 32 비트 키 (ID 문자열의 해시)
+// 파라미터 순서나 개수가 바뀌어도 같은 ID 는 같은 값으로 복원됨
+juce::uint32 getParameterKey(const juce::String& parameterID);
+
+// 작은 바이너리 상태 형식 (리틀 엔디언)
+// [magic][version][개수] 뒤로 (키, 실제 값) 쌍, 파라미터 하나에 8 바이트
+namespace CompactState
+{
+    constexpr juce::uint32 magic = 0x5145516e;   // "nQEQ"
+    constexpr juce::uint32 currentVersion = 1;
+
+    struct Entry
+    {
+        juce::uint32 key;
+        float value;
+    };
+
+    void write(juce::MemoryBlock& destination, const std::vector<Entry>& entries);
+
+    // magic 이 다르면 (예전 ValueTree 형식 등) false, 더 새로운 버전도 false
+    bool read(const void* data, int sizeInBytes, std::vector<Entry>& entries);
+}
+
+// 메모리 맵으로 여는 프리셋 라이브러리 파일
+// 파싱 없이 헤더만 확인하고, 프리셋 i 의 값은 고정된 위치에서 바로 읽음 (O(1) 조회)
+//
+// [magic][version][프리셋 수 P][파라미터 수 N]
+// [키 x N][이름 오프셋 x (P + 1)][값 float x (P * N)][이름 UTF-8]
+class PresetLibrary
+{
+public:
+    static constexpr juce::uint32 magic = 0x4c51456e;   // "nEQL"
+    static constexpr juce::uint32 currentVersion = 1;
+
+    PresetLibrary() = default;
+
+    // 파일을 맵핑하고 크기와 오프셋을 검사, 실패하면 닫힌 상태
+    bool open(const juce::File& file);
+    void close();
+
+    bool isOpen() const noexcept { return mappedFile != nullptr; }
+    int getNumPresets() const noexcept { return numPresets; }
+    int getNumParameters() const noexcept { return numParameters; }
+
+    juce::uint32 getParameterKey(int parameter) const noexcept;
+    float getValue(int preset, int parameter) const noexcept;
+    juce::String getName(int preset) const;
+
+    // values 는 프리셋마다 keys 순서의 실제 값 (names.size() * keys.size() 개)
+    static bool write(const juce::File& file, const std::vector<juce::uint32>& keys,
+                      const juce::StringArray& names, const std::vector<float>& values);
+
+private:
+    static constexpr int headerSize = 16;
+
+    juce::uint32 readUInt32(size_t offset) const noexcept;
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    const char* data = nullptr;
+    size_t dataSize = 0;
+    int numPresets = 0, numParameters = 0;
+    size_t keysOffset = 0, nameOffsetsOffset = 0, valuesOffset = 0, namesOffset = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetLibrary)
+};
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+    Created: 17 Oct 2026 11:08:33pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+
+
+void ResponseCurve::setSections(const BiquadCoefficients<double>* newSections, int newNumSections, double newSampleRate)
+{
+    jassert(newNumSections <= (int) sections.size());
+    newNumSections = juce::jmin(newNumSections, (int) sections.size());
+
+    std::copy(newSections, newSections + newNumSections, sections.begin());
+    numSections = newNumSections;
+    sampleRate = newSampleRate;
+
+    magnitudesValid = false;
+    pathValid = false;
+}
+
+const juce::Path& ResponseCurve::getPath(juce::Rectangle<float> area, int numPoints, float minDecibels, float maxDecibels)
+{
+    numPoints = juce::jmax(2, numPoints);
+
+    if (numPoints != gridPoints || sampleRate != gridSampleRate)
+    {
+        updateGrid(numPoints);
+        magnitudesValid = false;
+    }
+
+    if (! magnitudesValid)
+    {
+        updateMagnitudes();
+        pathValid = false;
+    }
+
+    if (pathValid && area == pathArea && minDecibels == pathMinDecibels && maxDecibels == pathMaxDecibels)
+        return path;
+
+    path.clear();
+    path.preallocateSpace(numPoints * 3);
+
+    const auto step = area.getWidth() / (float) (numPoints - 1);
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto x = area.getX() + step * (float) i;
+        const auto y = juce::jmap((float) decibels[(size_t) i], minDecibels, maxDecibels, area.getBottom(), area.getY());
+
+        if (i == 0)
+            path.startNewSubPath(x, y);
+        else
+            path.lineTo(x, y);
+    }
+
+    pathArea = area;
+    pathMinDecibels = minDecibels;
+    pathMaxDecibels = maxDecibels;
+    pathValid = true;
+
+    return path;
+}
+
+void ResponseCurve::updateGrid(int numPoints)
+{
+    const auto size = (size_t) numPoints;
+
+    cosW.resize(size);
+    cos2W.resize(size);
+    numerator.resize(size);
+    denominator.resize(size);
+    sectionTerm.resize(size);
+    decibels.resize(size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const auto freq = juce::mapToLog10((double) i / (double) (numPoints - 1), 20.0, 20000.0);
+        const auto w = sampleRate > 0.0 ? juce::MathConstants<double>::twoPi * freq / sampleRate : 0.0;
+        cosW[i] = std::cos(w);
+        cos2W[i] = std::cos(2.0 * w);
+    }
+
+    gridPoints = numPoints;
+    gridSampleRate = sampleRate;
+}
+
+void ResponseCurve::updateMagnitudes()
+{
+    const auto numPoints = gridPoints;
+
+    // 단위원 위에서 |b0 + b1 z^-1 + b2 z^-2|^2 = (b0^2 + b1^2 + b2^2) + 2(b0 b1 + b1 b2) cos w + 2 b0 b2 cos 2w
+    // 분모도 같은 꼴 (a0 = 1), 섹션마다 곱해서 마지막에 한 번만 나누고 로그를 취함
+    juce::FloatVectorOperations::fill(numerator.data(), 1.0, numPoints);
+    juce::FloatVectorOperations::fill(denominator.data(), 1.0, numPoints);
+
+    auto accumulate = [&](std::vector<double>& product, double c0, double c1, double c2)
+    {
+        juce::FloatVectorOperations::fill(sectionTerm.data(), c0, numPoints);
+        juce::FloatVectorOperations::addWithMultiply(sectionTerm.data(), cosW.data(), c1, numPoints);
+        juce::FloatVectorOperations::addWithMultiply(sectionTerm.data(), cos2W.data(), c2, numPoints);
+        juce::FloatVectorOperations::multiply(product.data(), sectionTerm.data(), numPoints);
+    };
+
+    for (int s = 0; s < numSections; ++s)
+    {
+        const auto& c = sections[(size_t) s];
+
+        accumulate(numerator, c.b0 * c.b0 + c.b1 * c.b1 + c.b2 * c.b2, 2.0 * (c.b0 * c.b1 + c.b1 * c.b2), 2.0 * c.b0 * c.b2);
+        accumulate(denominator, 1.0 + c.a1 * c.a1 + c.a2 * c.a2, 2.0 * (c.a1 + c.a1 * c.a2), 2.0 * c.a2);
+    }
+
+    // 아주 깊은 감쇠(컷 필터의 저지대역)도 화면 아래로 충분히 내려가도록 -200 dB 에서 자름
+    constexpr double floor = 1.0e-20;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto power = numerator[(size_t) i] / juce::jmax(denominator[(size_t) i], floor);
+        decibels[(size_t) i] = 10.0 * std::log10(juce::jmax(power, floor));
+    }
+
+    magnitudesValid = true;
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 17 Oct 2026 11:08:33pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDFilterEngine.h"
+
+
+// 에디터의 진폭 응답 곡선
+// 로그 주파수 격자(cos w, cos 2w)는 점 개수나 샘플 레이트가 바뀔 때만 만들고
+// |H|^2 를 실수 다항식으로 풀어서 모든 점을 섹션마다 벡터 연산 몇 번으로 계산한다
+// 결과 경로는 계수나 크기가 바뀔 때까지 재사용하므로 paint 는 그리기만 함
+class ResponseCurve
+{
+public:
+    ResponseCurve() = default;
+
+    // 메시지 스레드, 섹션이 바뀌었을 때만 다시 계산하도록 표시
+    void setSections(const BiquadCoefficients<double>* sections, int numSections, double sampleRate);
+
+    // area 에 맞춘 경로, numPoints 는 보통 물리 픽셀 수 (HiDPI 에서는 논리 폭 * 배율)
+    // minDecibels ~ maxDecibels 가 area 의 아래 ~ 위
+    const juce::Path& getPath(juce::Rectangle<float> area, int numPoints, float minDecibels, float maxDecibels);
+
+private:
+    void updateGrid(int numPoints);
+    void updateMagnitudes();
+
+    std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxSections> sections;
+    int numSections = 0;
+    double sampleRate = 0.0;
+
+    // 점마다의 cos w, cos 2w 와 계산용 버퍼, 점 개수가 바뀔 때만 다시 할당
+    std::vector<double> cosW, cos2W, numerator, denominator, sectionTerm, decibels;
+    int gridPoints = 0;
+    double gridSampleRate = 0.0;
+
+    bool magnitudesValid = false;
+
+    juce::Path path;
+    juce::Rectangle<float> pathArea;
+    float pathMinDecibels = 0.f, pathMaxDecibels = 0.f;
+    bool pathValid = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponseCurve)
+};
@@ -0,0 +1,633 @@
+/*
+  ==============================================================================
+
+    SIMDFilterEngine.h
+    Created: 17 Oct 2026 10:12:41am
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+// a0 = 1 로 정규화된 바이쿼드 계수
+// 1차 필터는 b2 = a2 = 0 인 바이쿼드로 취급한다
+template <typename SampleType>
+struct BiquadCoefficients
+{
+    SampleType b0 {1}, b1 {0}, b2 {0}, a1 {0}, a2 {0};
+};
+
+// juce::dsp::IIR::Coefficients 의 배열은 [b0, b1, ..., bN, a1, ..., aN] 순서
+template <typename SampleType>
+BiquadCoefficients<SampleType> toBiquadCoefficients(const juce::dsp::IIR::Coefficients<SampleType>& coefficients)
+{
+    const auto* raw = coefficients.coefficients.begin();
+    BiquadCoefficients<SampleType> biquad;
+
+    if (coefficients.getFilterOrder() == 1)
+    {
+        biquad.b0 = raw[0];
+        biquad.b1 = raw[1];
+        biquad.a1 = raw[2];
+    }
+    else
+    {
+        jassert(coefficients.getFilterOrder() == 2);
+
+        biquad.b0 = raw[0];
+        biquad.b1 = raw[1];
+        biquad.b2 = raw[2];
+        biquad.a1 = raw[3];
+        biquad.a2 = raw[4];
+    }
+
+    return biquad;
+}
+
+// 주어진 주파수에서의 진폭 응답 |H(e^jw)|
+template <typename SampleType>
+double getMagnitudeForFrequency(const BiquadCoefficients<SampleType>& coefficients, double frequency, double sampleRate)
+{
+    const auto w = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const auto z1 = std::polar(1.0, -w);
+    const auto z2 = z1 * z1;
+
+    const auto numerator = (double) coefficients.b0 + (double) coefficients.b1 * z1 + (double) coefficients.b2 * z2;
+    const auto denominator = 1.0 + (double) coefficients.a1 * z1 + (double) coefficients.a2 * z2;
+
+    return std::abs(numerator / denominator);
+}
+
+// 가장 큰 극점의 크기, 복소 켤레 극점이면 |p|^2 = a2
+template <typename SampleType>
+double getPoleRadius(const BiquadCoefficients<SampleType>& coefficients)
+{
+    const auto a1 = (double) coefficients.a1;
+    const auto a2 = (double) coefficients.a2;
+    const auto discriminant = a1 * a1 - 4.0 * a2;
+
+    if (discriminant < 0.0)
+        return std::sqrt(a2);
+
+    const auto root = std::sqrt(discriminant);
+    return 0.5 * juce::jmax(std::abs(-a1 + root), std::abs(-a1 - root));
+}
+
+// 임펄스 응답이 attenuation (선형 이득) 아래로 줄어들 때까지 걸리는 샘플 수
+template <typename SampleType>
+double getDecaySamples(const BiquadCoefficients<SampleType>& coefficients, double attenuation)
+{
+    const auto radius = getPoleRadius(coefficients);
+
+    // 극점이 없으면 분자 차수만큼만 남음
+    if (radius <= 0.0)
+        return 2.0;
+
+    // 설계된 필터는 항상 안정해야 함
+    jassert(radius < 1.0);
+
+    if (radius >= 1.0)
+        return 0.0;
+
+    return 2.0 + std::log(attenuation) / std::log(radius);
+}
+
+template <typename SampleType>
+bool isIdentity(const BiquadCoefficients<SampleType>& coefficients)
+{
+    return coefficients.b0 == SampleType(1) && coefficients.b1 == SampleType(0) && coefficients.b2 == SampleType(0)
+        && coefficients.a1 == SampleType(0) && coefficients.a2 == SampleType(0);
+}
+
+
+//==============================================================================
+// 엔진이 섹션 하나를 처리하는 방식 (토폴로지)
+// Parameters 는 보간되는 값, Coefficients 는 샘플 처리에 쓰이는 값
+// 바이쿼드는 두 가지가 같고, 다른 토폴로지는 Parameters 에서 Coefficients 를 계산한다
+
+// Transposed Direct Form II 바이쿼드, 계수를 그대로 보간
+template <typename SampleType>
+struct BiquadTopology
+{
+    using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+
+    enum { b0, b1, b2, a1, a2, numParameters };
+
+    using Parameters = std::array<SIMDType, numParameters>;
+    using Coefficients = Parameters;
+
+    struct State
+    {
+        SIMDType s1 {}, s2 {};
+    };
+
+    static Parameters identity() noexcept
+    {
+        return { SIMDType::expand(SampleType(1)), SIMDType::expand(SampleType(0)), SIMDType::expand(SampleType(0)),
+                 SIMDType::expand(SampleType(0)), SIMDType::expand(SampleType(0)) };
+    }
+
+    template <typename CoefficientType>
+    static Parameters toParameters(const BiquadCoefficients<CoefficientType>& c) noexcept
+    {
+        return { SIMDType::expand(static_cast<SampleType>(c.b0)), SIMDType::expand(static_cast<SampleType>(c.b1)),
+                 SIMDType::expand(static_cast<SampleType>(c.b2)), SIMDType::expand(static_cast<SampleType>(c.a1)),
+                 SIMDType::expand(static_cast<SampleType>(c.a2)) };
+    }
+
+    static forcedinline const Coefficients& getCoefficients(const Parameters& parameters) noexcept
+    {
+        return parameters;
+    }
+
+    static forcedinline SIMDType processSample(const Coefficients& c, State& s, SIMDType x) noexcept
+    {
+        const auto y = c[b0] * x + s.s1;
+        s.s1 = c[b1] * x - c[a1] * y + s.s2;
+        s.s2 = c[b2] * x - c[a2] * y;
+        return y;
+    }
+};
+
+
+//==============================================================================
+// 채널들을 SIMD 레지스터의 각 레인에 넣어 한 번에 처리하는 필터 엔진
+// 계수는 한 벌만 가지고 모든 레지스터가 공유한다 (레인 마스크를 주면 레인마다 다른 계수)
+// 채널 수가 레인 수보다 많으면 (5.1, 7.1.4, 앰비소닉 등) 레지스터를 여러 개 사용
+// 섹션의 구조는 Topology 로 정함 (기본은 바이쿼드, SVFFilter.h 의 SVFTopology)
+template <typename SampleType, typename Topology = BiquadTopology<SampleType>>
+class SIMDFilterEngine
+{
+public:
+    using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int maxCutSections = 4;
+
+    // 로우컷, 피크, 하이컷 외에 추가로 쓸 수 있는 단일 섹션 밴드 수 (합쳐서 24 밴드)
+    static constexpr int maxBands = 21;
+    static constexpr int maxSections = maxCutSections * 2 + 1 + maxBands;
+    static constexpr int lanes = (int) SIMDType::SIMDNumElements;
+
+    // 레인 마스크의 비트 i 는 모든 레지스터의 레인 i, 마스크 밖의 레인은 항등 섹션
+    // Mid/Side 모드에서는 레인 0 이 Mid, 레인 1 이 Side
+    static constexpr juce::uint32 allLanes = 0xffffffff;
+    static constexpr juce::uint32 midLane = 1, sideLane = 2;
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        numChannels = (int) spec.numChannels;
+        numRegisters = juce::jmax(1, (numChannels + lanes - 1) / lanes);
+        maxBlockSize = (int) spec.maximumBlockSize;
+
+        // 쓰이지 않는 레인은 항상 0 으로 남도록 전부 0 으로 초기화
+        frames.assign((size_t) (numRegisters * maxBlockSize), SIMDType::expand(SampleType(0)));
+        states.assign((size_t) (numRegisters * maxSections), SectionState());
+
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& state : states)
+            state = SectionState();
+
+        finishRamp();
+    }
+
+    // 두 채널을 Mid/Side 로 바꿔서 처리 (채널이 둘일 때만)
+    // 변환은 레인에 옮겨 담는 복사 안에서 함께 하므로 버퍼를 더 읽지 않음
+    // 상태가 다른 신호에서 쌓인 것이므로 바뀌면 초기화
+    void setMidSide(bool shouldUseMidSide)
+    {
+        if (shouldUseMidSide == midSide)
+            return;
+
+        midSide = shouldUseMidSide;
+        reset();
+    }
+
+    bool isMidSide() const noexcept { return midSide; }
+
+    // rampLength > 0 이면 현재 계수에서 새 계수까지 rampLength 샘플 동안 선형 보간
+    // 계수는 double 로 설계된 것도 받을 수 있고 엔진의 샘플 타입으로 변환해서 저장
+    template <typename SectionType>
+    void setLowCut(const SectionType* newSections, int numSections, int rampLength = 0, juce::uint32 laneMask = allLanes)
+    {
+        setCutSections(lowCutStart, numLowCutSections, newSections, numSections, rampLength, laneMask);
+    }
+
+    // 항등 섹션(계수 구조체의 기본값)을 넣으면 보간이 끝난 뒤 피크 섹션을 건너뜀
+    template <typename SectionType>
+    void setPeak(const SectionType& newSection, int rampLength = 0, juce::uint32 laneMask = allLanes)
+    {
+        setSingleSection(peakIndex, newSection, rampLength, laneMask);
+    }
+
+    template <typename SectionType>
+    void setHighCut(const SectionType* newSections, int numSections, int rampLength = 0, juce::uint32 laneMask = allLanes)
+    {
+        setCutSections(highCutStart, numHighCutSections, newSections, numSections, rampLength, laneMask);
+    }
+
+    // 추가 밴드, 피크와 마찬가지로 항등 섹션이면 꺼진 밴드
+    // 켜고 끄는 것은 활성 목록만 다시 만들 뿐 할당이 없음
+    template <typename SectionType>
+    void setBand(int band, const SectionType& newSection, int rampLength = 0, juce::uint32 laneMask = allLanes)
+    {
+        jassert(juce::isPositiveAndBelow(band, maxBands));
+        setSingleSection(bandStart + band, newSection, rampLength, laneMask);
+    }
+
+    // 처리할 섹션이 하나도 없으면 process 가 버퍼를 건드리지 않음
+    bool isNeutral() const noexcept
+    {
+        return numActiveSlots == 0 && rampRemaining == 0;
+    }
+
+    int getNumActiveSections() const noexcept { return numActiveSlots; }
+
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context)
+    {
+        auto& block = context.getOutputBlock();
+        const auto numSamples = (int) block.getNumSamples();
+        const auto channelsToProcess = juce::jmin(numChannels, (int) block.getNumChannels());
+
+        jassert(numSamples <= maxBlockSize);
+
+        if (context.isBypassed || numSamples == 0 || channelsToProcess == 0 || isNeutral())
+            return;
+
+        interleave(block, channelsToProcess, numSamples);
+
+        auto start = 0;
+
+        // 보간 중인 구간만 보간 커널로 처리하고 나머지는 고정 계수 커널로 처리
+        if (rampRemaining > 0)
+        {
+            const auto rampSamples = juce::jmin(rampRemaining, numSamples);
+            processSections<true>(start, rampSamples);
+
+            rampRemaining -= rampSamples;
+            start += rampSamples;
+
+            if (rampRemaining == 0)
+                finishRamp();
+        }
+
+        if (start < numSamples)
+            processSections<false>(start, numSamples - start);
+
+        deinterleave(block, channelsToProcess, numSamples);
+    }
+
+private:
+    using Parameters = typename Topology::Parameters;
+    using Coefficients = typename Topology::Coefficients;
+    using SectionState = typename Topology::State;
+
+    static constexpr int numParameters = (int) Topology::numParameters;
+
+    static constexpr int lowCutStart = 0;
+    static constexpr int peakIndex = maxCutSections;
+    static constexpr int highCutStart = maxCutSections + 1;
+    static constexpr int bandStart = maxCutSections * 2 + 1;
+
+    // 한 번에 샘플마다 통과시키는 섹션 수, 계수와 상태가 레지스터에 머물 수 있는 크기
+    static constexpr int maxChunkSections = 4;
+
+    // 모든 섹션의 값을 값 종류별로 모아 둔 구조체 배열(SoA) [parameter][slot]
+    // parameters 는 지금 쓰이는 값, targets 는 보간이 끝났을 때의 값
+    // deltas 는 샘플당 증가량, 보간 중이 아닐 때는 0
+    using ParameterPool = std::array<std::array<SIMDType, maxSections>, numParameters>;
+    ParameterPool parameters = makeIdentityPool(), targets = makeIdentityPool(), deltas = makeZeroPool();
+    int numLowCutSections = 0, numHighCutSections = 0;
+    int rampRemaining = 0;
+
+    // 단일 섹션(피크, 추가 밴드)의 목표가 항등인지와 지금 처리 중인지
+    // 항등이 된 섹션은 보간이 끝난 뒤 활성 목록에서 빠짐
+    std::array<bool, maxSections> targetNeutral = makeFilledFlags(true), slotActive = makeFilledFlags(false);
+
+    // 처리 순서대로 모은 활성 슬롯 (로우컷 -> 피크 -> 하이컷 -> 추가 밴드)
+    std::array<int, maxSections> activeSlots {};
+    int numActiveSlots = 0;
+
+    // 상태는 레지스터마다 한 벌 [register * maxSections + section]
+    std::vector<SectionState> states;
+
+    // 레지스터별로 연속된 샘플 [register * maxBlockSize + sample], 각 레인이 채널 하나
+    std::vector<SIMDType> frames;
+    int numChannels = 0, numRegisters = 0, maxBlockSize = 0;
+    bool midSide = false;
+
+    static ParameterPool makeIdentityPool() noexcept
+    {
+        const auto identity = Topology::identity();
+        ParameterPool pool;
+
+        for (size_t p = 0; p < (size_t) numParameters; ++p)
+            pool[p].fill(identity[p]);
+
+        return pool;
+    }
+
+    static ParameterPool makeZeroPool() noexcept
+    {
+        ParameterPool pool;
+
+        for (auto& values : pool)
+            values.fill(SIMDType::expand(SampleType(0)));
+
+        return pool;
+    }
+
+    static std::array<bool, maxSections> makeFilledFlags(bool value) noexcept
+    {
+        std::array<bool, maxSections> flags;
+        flags.fill(value);
+        return flags;
+    }
+
+    static forcedinline Parameters gather(const ParameterPool& pool, size_t slot) noexcept
+    {
+        Parameters values;
+
+        for (size_t p = 0; p < (size_t) numParameters; ++p)
+            values[p] = pool[p][slot];
+
+        return values;
+    }
+
+    template <typename SectionType>
+    void setSection(int slot, const SectionType& newSection, int rampLength, juce::uint32 laneMask) noexcept
+    {
+        const auto newParameters = maskLanes(Topology::toParameters(newSection), laneMask);
+
+        for (size_t p = 0; p < (size_t) numParameters; ++p)
+            targets[p][(size_t) slot] = newParameters[p];
+
+        if (rampLength > 0)
+        {
+            startRamp(rampLength);
+        }
+        else
+        {
+            for (size_t p = 0; p < (size_t) numParameters; ++p)
+            {
+                parameters[p][(size_t) slot] = targets[p][(size_t) slot];
+                deltas[p][(size_t) slot] = SIMDType::expand(SampleType(0));
+            }
+        }
+    }
+
+    template <typename SectionType>
+    void setSingleSection(int slot, const SectionType& newSection, int rampLength, juce::uint32 laneMask) noexcept
+    {
+        targetNeutral[(size_t) slot] = isIdentity(newSection) || laneMask == 0;
+        setSection(slot, newSection, rampLength, laneMask);
+        updateActiveSlots();
+    }
+
+    template <typename SectionType>
+    void setCutSections(int start, int& numActive,
+                        const SectionType* newSections, int numSections, int rampLength, juce::uint32 laneMask)
+    {
+        jassert(juce::isPositiveAndNotGreaterThan(numSections, maxCutSections));
+
+        // 섹션 수가 바뀌면 보간할 대상이 없으므로 바로 적용
+        if (numSections != numActive)
+            rampLength = 0;
+
+        for (int i = 0; i < numSections; ++i)
+            setSection(start + i, newSections[i], rampLength, laneMask);
+
+        numActive = numSections;
+        updateActiveSlots();
+    }
+
+    // 진행 중이던 보간도 새 길이에 맞춰 다시 계산해서 모든 섹션이 같은 시점에 목표에 도달하게 함
+    void startRamp(int rampLength) noexcept
+    {
+        const auto step = SIMDType::expand(SampleType(1) / (SampleType) rampLength);
+
+        for (size_t p = 0; p < (size_t) numParameters; ++p)
+            for (size_t k = 0; k < (size_t) maxSections; ++k)
+                deltas[p][k] = (targets[p][k] - parameters[p][k]) * step;
+
+        rampRemaining = rampLength;
+    }
+
+    // 누적 오차가 남지 않도록 목표 계수로 정확히 맞춤
+    void finishRamp() noexcept
+    {
+        parameters = targets;
+        deltas = makeZeroPool();
+        rampRemaining = 0;
+
+        updateActiveSlots();
+    }
+
+    // 섹션 구성이 바뀔 때만 호출, 블록 처리 중에는 목록을 그대로 따라가기만 함
+    void updateActiveSlots() noexcept
+    {
+        numActiveSlots = 0;
+
+        for (int slot = 0; slot < maxSections; ++slot)
+        {
+            const auto wasActive = slotActive[(size_t) slot];
+            bool active;
+
+            if (slot < peakIndex)
+                active = slot - lowCutStart < numLowCutSections;
+            else if (slot >= highCutStart && slot < bandStart)
+                active = slot - highCutStart < numHighCutSections;
+            else
+                // 꺼지는 중이면 항등에 도달할 때까지 계속 처리
+                active = ! targetNeutral[(size_t) slot] || (wasActive && rampRemaining > 0);
+
+            // 새로 켜지는 섹션은 예전 상태가 남아 있으면 튀는 소리가 나므로 초기화
+            if (active && ! wasActive)
+                for (int r = 0; r < numRegisters; ++r)
+                    states[(size_t) (r * maxSections + slot)] = SectionState();
+
+            slotActive[(size_t) slot] = active;
+
+            if (active)
+                activeSlots[(size_t) numActiveSlots++] = slot;
+        }
+    }
+
+    // 마스크 밖의 레인을 항등 섹션으로 바꿈, 계수를 바꿀 때만 불림
+    static Parameters maskLanes(const Parameters& section, juce::uint32 laneMask) noexcept
+    {
+        if (laneMask == allLanes)
+            return section;
+
+        auto masked = Topology::identity();
+
+        for (size_t p = 0; p < (size_t) numParameters; ++p)
+            for (size_t lane = 0; lane < (size_t) lanes; ++lane)
+                if ((laneMask >> lane) & 1u)
+                    masked[p].set(lane, section[p].get(lane));
+
+        return masked;
+    }
+
+    static forcedinline void advance(Parameters& p, const Parameters& delta) noexcept
+    {
+        for (size_t i = 0; i < (size_t) numParameters; ++i)
+            p[i] += delta[i];
+    }
+
+    // 활성 섹션을 최대 maxChunkSections 개씩 묶어 처리, 섹션 수에 따른 분기는 묶음마다 한 번
+    // 밴드가 늘어나도 처리량은 활성 섹션 수에만 비례함
+    template <bool Ramping>
+    void processSections(int start, int numSamples) noexcept
+    {
+        for (int first = 0; first < numActiveSlots; first += maxChunkSections)
+        {
+            const auto* slots = activeSlots.data() + first;
+
+            switch (juce::jmin(maxChunkSections, numActiveSlots - first))
+            {
+                case 1: processChunk<Ramping, 1>(slots, start, numSamples); break;
+                case 2: processChunk<Ramping, 2>(slots, start, numSamples); break;
+                case 3: processChunk<Ramping, 3>(slots, start, numSamples); break;
+                case 4: processChunk<Ramping, 4>(slots, start, numSamples); break;
+                default: jassertfalse; break;
+            }
+        }
+
+        // 비활성 섹션도 목표를 향해 함께 진행시켜 다음 보간 계산이 어긋나지 않게 함
+        if constexpr (Ramping)
+        {
+            const auto samples = SIMDType::expand((SampleType) numSamples);
+
+            for (size_t p = 0; p < (size_t) numParameters; ++p)
+                for (size_t k = 0; k < (size_t) maxSections; ++k)
+                    parameters[p][k] += deltas[p][k] * samples;
+        }
+    }
+
+    // 묶음 안의 섹션을 샘플마다 한 번에 통과시킴
+    // 섹션 수가 컴파일 타임에 정해지므로 안쪽 루프가 풀리고 상태는 지역 변수(레지스터)에 머문다
+    // Ramping 이면 샘플마다 보간 값에 증가량을 더하고 토폴로지가 그 값으로 계수를 만듦
+    template <bool Ramping, int NumSections>
+    void processChunk(const int* slots, int start, int numSamples) noexcept
+    {
+        Parameters current[NumSections], delta[NumSections];
+        Coefficients cascade[NumSections];
+
+        for (int r = 0; r < numRegisters; ++r)
+        {
+            auto* registerStates = states.data() + r * maxSections;
+            auto* samples = frames.data() + r * maxBlockSize + start;
+
+            // 보간 중에는 레지스터마다 같은 시작 계수에서 출발해야 함
+            for (int k = 0; k < NumSections; ++k)
+            {
+                const auto slot = (size_t) slots[k];
+
+                if constexpr (Ramping)
+                {
+                    current[k] = gather(parameters, slot);
+                    delta[k] = gather(deltas, slot);
+                }
+                else
+                {
+                    cascade[k] = Topology::getCoefficients(gather(parameters, slot));
+                }
+            }
+
+            SectionState state[NumSections];
+
+            for (int k = 0; k < NumSections; ++k)
+                state[k] = registerStates[slots[k]];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto x = samples[i];
+
+                for (int k = 0; k < NumSections; ++k)
+                {
+                    if constexpr (Ramping)
+                    {
+                        advance(current[k], delta[k]);
+                        x = Topology::processSample(Topology::getCoefficients(current[k]), state[k], x);
+                    }
+                    else
+                    {
+                        x = Topology::processSample(cascade[k], state[k], x);
+                    }
+                }
+
+                samples[i] = x;
+            }
+
+            for (int k = 0; k < NumSections; ++k)
+                registerStates[slots[k]] = state[k];
+        }
+    }
+
+    void interleave(const juce::dsp::AudioBlock<SampleType>& block, int channelsToProcess, int numSamples) noexcept
+    {
+        // M = (L + R) / 2 는 레인 0, S = (L - R) / 2 는 레인 1
+        if (midSide && channelsToProcess == 2)
+        {
+            const auto* left = block.getChannelPointer(0);
+            const auto* right = block.getChannelPointer(1);
+            auto* raw = reinterpret_cast<SampleType*>(frames.data());
+            const auto half = SampleType(0.5);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                raw[i * lanes] = half * (left[i] + right[i]);
+                raw[i * lanes + 1] = half * (left[i] - right[i]);
+            }
+
+            return;
+        }
+
+        for (int ch = 0; ch < channelsToProcess; ++ch)
+        {
+            const auto* source = block.getChannelPointer((size_t) ch);
+            auto* raw = reinterpret_cast<SampleType*>(frames.data() + (ch / lanes) * maxBlockSize) + ch % lanes;
+
+            for (int i = 0; i < numSamples; ++i)
+                raw[i * lanes] = source[i];
+        }
+    }
+
+    void deinterleave(juce::dsp::AudioBlock<SampleType>& block, int channelsToProcess, int numSamples) const noexcept
+    {
+        // L = M + S, R = M - S
+        if (midSide && channelsToProcess == 2)
+        {
+            auto* left = block.getChannelPointer(0);
+            auto* right = block.getChannelPointer(1);
+            const auto* raw = reinterpret_cast<const SampleType*>(frames.data());
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto mid = raw[i * lanes];
+                const auto side = raw[i * lanes + 1];
+                left[i] = mid + side;
+                right[i] = mid - side;
+            }
+
+            return;
+        }
+
+        for (int ch = 0; ch < channelsToProcess; ++ch)
+        {
+            auto* destination = block.getChannelPointer((size_t) ch);
+            const auto* raw = reinterpret_cast<const SampleType*>(frames.data() + (ch / lanes) * maxBlockSize) + ch % lanes;
+
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] = raw[i * lanes];
+        }
+    }
+};
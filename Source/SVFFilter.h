@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    SVFFilter.h
+    Created: 17 Oct 2026 6:02:37pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SIMDFilterEngine.h"
+#include "BiquadDesign.h"
+
+
+// TPT(topology-preserving transform) 상태 변수 필터 한 섹션
+// g = tan(pi * fc / fs), k = 1 / Q, 출력은 m0 * 입력 + m1 * 밴드패스 + m2 * 로우패스
+// poles 가 1 이면 1차 섹션 (밴드패스 출력이 0 이 되고 k 는 1 로 둠)
+// 기본값은 항등 섹션 (g = 0 이면 상태가 움직이지 않고 출력은 m0 * 입력)
+template <typename SampleType>
+struct SVFCoefficients
+{
+    SampleType g {0}, k {1}, m0 {1}, m1 {0}, m2 {0};
+    int poles = 2;
+};
+
+template <typename SampleType>
+bool isIdentity(const SVFCoefficients<SampleType>& coefficients)
+{
+    return coefficients.g == SampleType(0) && coefficients.m0 == SampleType(1)
+        && coefficients.m1 == SampleType(0) && coefficients.m2 == SampleType(0);
+}
+
+// 피크(벨), A = 10^(dB / 40) 일 때 k = 1 / (Q * A), m1 = k * (A^2 - 1)
+template <typename SampleType>
+SVFCoefficients<SampleType> makeSVFPeak(double frequency, double quality, double gainInDecibels, double sampleRate)
+{
+    const auto A = std::pow(10.0, gainInDecibels / 40.0);
+    const auto k = 1.0 / (quality * A);
+
+    SVFCoefficients<SampleType> section;
+    section.g = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate));
+    section.k = static_cast<SampleType>(k);
+    section.m1 = static_cast<SampleType>(k * (A * A - 1.0));
+    return section;
+}
+
+// 로우 셸프, 낮은 쪽이 A^2 (dB 만큼) 올라감
+template <typename SampleType>
+SVFCoefficients<SampleType> makeSVFLowShelf(double frequency, double quality, double gainInDecibels, double sampleRate)
+{
+    const auto A = std::pow(10.0, gainInDecibels / 40.0);
+    const auto k = 1.0 / quality;
+
+    SVFCoefficients<SampleType> section;
+    section.g = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate) / std::sqrt(A));
+    section.k = static_cast<SampleType>(k);
+    section.m1 = static_cast<SampleType>(k * (A - 1.0));
+    section.m2 = static_cast<SampleType>(A * A - 1.0);
+    return section;
+}
+
+// 하이 셸프, 높은 쪽이 A^2 (dB 만큼) 올라감
+template <typename SampleType>
+SVFCoefficients<SampleType> makeSVFHighShelf(double frequency, double quality, double gainInDecibels, double sampleRate)
+{
+    const auto A = std::pow(10.0, gainInDecibels / 40.0);
+    const auto k = 1.0 / quality;
+
+    SVFCoefficients<SampleType> section;
+    section.g = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate) * std::sqrt(A));
+    section.k = static_cast<SampleType>(k);
+    section.m0 = static_cast<SampleType>(A * A);
+    section.m1 = static_cast<SampleType>(k * (1.0 - A) * A);
+    section.m2 = static_cast<SampleType>(1.0 - A * A);
+    return section;
+}
+
+template <typename SampleType>
+SVFCoefficients<SampleType> makeSVFNotch(double frequency, double quality, double sampleRate)
+{
+    SVFCoefficients<SampleType> section;
+    section.g = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate));
+    section.k = static_cast<SampleType>(1.0 / quality);
+    section.m1 = -section.k;
+    return section;
+}
+
+// order 차 버터워스를 2차 섹션(홀수 차수면 1차 섹션 하나 추가)으로 나눔, 섹션 수를 반환
+// 쌍선형 변환 기준으로 JUCE 의 FilterDesign 버터워스와 같은 응답
+// (셸프, 노치도 IIR::Coefficients 의 makeLowShelf, makeHighShelf, makeNotch 와 같은 응답)
+template <typename SampleType>
+int makeSVFButterworth(bool isHighPass, double frequency, int order, double sampleRate,
+                       SVFCoefficients<SampleType>* sections, int maxSections)
+{
+    const auto g = static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * frequency / sampleRate));
+    const auto numSections = (order + 1) / 2;
+    jassert(numSections <= maxSections);
+    juce::ignoreUnused(maxSections);
+
+    jassert(order >= 1 && order <= ButterworthPoles::maxOrder);
+
+    for (int i = 0; i < order / 2; ++i)
+    {
+        // k = 1 / Q 는 극점 표에서 바로 읽음
+        auto& section = sections[i];
+        section = {};
+        section.g = g;
+        section.k = static_cast<SampleType>(ButterworthPoles::inverseQ[order][i]);
+        section.m0 = isHighPass ? SampleType(1) : SampleType(0);
+        section.m1 = isHighPass ? -section.k : SampleType(0);
+        section.m2 = isHighPass ? SampleType(-1) : SampleType(1);
+    }
+
+    if (order % 2 == 1)
+    {
+        auto& section = sections[numSections - 1];
+        section = {};
+        section.g = g;
+        section.poles = 1;
+        section.m0 = isHighPass ? SampleType(1) : SampleType(0);
+        section.m2 = isHighPass ? SampleType(-1) : SampleType(1);
+    }
+
+    return numSections;
+}
+
+
+//==============================================================================
+// 엔진용 SVF 토폴로지, g 와 k 를 보간하고 a1, a2, a3 는 샘플마다 닫힌 식으로 계산
+// g, k 가 양수인 한 어떤 값에서도 안정하므로 매 샘플 계수가 바뀌어도 안전 (나눗셈은 섹션당 레인 수만큼)
+template <typename SampleType>
+struct SVFTopology
+{
+    using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+
+    // p 는 2차 섹션이면 1, 1차 섹션이면 0
+    enum { g, k, p, m0, m1, m2, numParameters };
+
+    using Parameters = std::array<SIMDType, numParameters>;
+
+    struct Coefficients
+    {
+        SIMDType a1, a2, a3, m0, m1, m2;
+    };
+
+    struct State
+    {
+        SIMDType ic1 {}, ic2 {};
+    };
+
+    static Parameters identity() noexcept
+    {
+        return toParameters(SVFCoefficients<SampleType>());
+    }
+
+    template <typename CoefficientType>
+    static Parameters toParameters(const SVFCoefficients<CoefficientType>& c) noexcept
+    {
+        return { SIMDType::expand(static_cast<SampleType>(c.g)), SIMDType::expand(static_cast<SampleType>(c.k)),
+                 SIMDType::expand(c.poles == 2 ? SampleType(1) : SampleType(0)),
+                 SIMDType::expand(static_cast<SampleType>(c.m0)), SIMDType::expand(static_cast<SampleType>(c.m1)),
+                 SIMDType::expand(static_cast<SampleType>(c.m2)) };
+    }
+
+    // d = 1 / (1 + g (p g + k)), a1 = p d, a2 = g a1, a3 = g d (p g + 1 - p)
+    // p = 1 이면 일반적인 SVF, p = 0 이면 1차 (a3 = g / (1 + g))
+    // Mid/Side 배치에서는 레인마다 g, k, p 가 다르므로 레인별로 계산
+    // SIMDRegister 에는 나눗셈이 없어서 역수만 레인마다 구하고 나머지는 SIMD 연산
+    static forcedinline Coefficients getCoefficients(const Parameters& parameters) noexcept
+    {
+        const auto one = SIMDType::expand(SampleType(1));
+        const auto pg = parameters[p] * parameters[g];
+        const auto denominator = one + parameters[g] * (pg + parameters[k]);
+
+        auto d = denominator;
+
+        for (size_t lane = 0; lane < SIMDType::SIMDNumElements; ++lane)
+            d.set(lane, SampleType(1) / denominator.get(lane));
+
+        Coefficients c;
+        c.a1 = parameters[p] * d;
+        c.a2 = parameters[g] * c.a1;
+        c.a3 = parameters[g] * d * (pg + one - parameters[p]);
+        c.m0 = parameters[m0];
+        c.m1 = parameters[m1];
+        c.m2 = parameters[m2];
+        return c;
+    }
+
+    static forcedinline SIMDType processSample(const Coefficients& c, State& s, SIMDType x) noexcept
+    {
+        const auto v3 = x - s.ic2;
+        const auto v1 = c.a1 * s.ic1 + c.a2 * v3;
+        const auto v2 = s.ic2 + c.a2 * s.ic1 + c.a3 * v3;
+
+        s.ic1 = v1 + v1 - s.ic1;
+        s.ic2 = v2 + v2 - s.ic2;
+
+        return c.m0 * x + c.m1 * v1 + c.m2 * v2;
+    }
+};
+
+template <typename SampleType>
+using SVFFilterEngine = SIMDFilterEngine<SampleType, SVFTopology<SampleType>>;
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 17 Oct 2026 10:26:48pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+
+SpectrumAnalyzer::SpectrumAnalyzer() : juce::Thread("normalEQ Spectrum Analyzer")
+{
+    prepare(44100.0, 2);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stopThread(1000);
+}
+
+void SpectrumAnalyzer::prepare(double sampleRate, int numChannels)
+{
+    const juce::ScopedLock sl(analysisLock);
+
+    // 블록 크기와 상관없이 분석 스레드가 잠시 늦어도 넘치지 않도록 넉넉하게
+    const auto fifoSize = juce::jmax(fftSize * 4, juce::nextPowerOfTwo((int) (sampleRate * 0.25)));
+
+    for (auto& tap : taps)
+    {
+        tap.fifo = std::make_unique<juce::AbstractFifo>(fifoSize);
+        tap.fifoBuffer.setSize(juce::jlimit(1, 2, numChannels), fifoSize);
+        tap.timeBuffer.assign((size_t) fftSize, 0.f);
+        tap.levels.assign((size_t) numPathPoints, minDecibels);
+        tap.numBuffered = 0;
+        tap.publishedSilence = false;
+    }
+
+    fftData.assign((size_t) fftSize * 2, 0.f);
+
+    const auto maxBin = (float) (fftSize / 2 - 1);
+
+    for (int i = 0; i < numPathPoints; ++i)
+    {
+        const auto freq = juce::mapToLog10((double) i / (numPathPoints - 1), 20.0, 20000.0);
+        pointBins[(size_t) i] = juce::jmin(maxBin, (float) (freq * fftSize / sampleRate));
+    }
+}
+
+void SpectrumAnalyzer::addViewer()
+{
+    if (numViewers.fetch_add(1) == 0)
+        startThread();
+}
+
+void SpectrumAnalyzer::removeViewer()
+{
+    if (numViewers.fetch_sub(1) == 1)
+        stopThread(1000);
+}
+
+void SpectrumAnalyzer::getPath(Tap tap, juce::Path& destination) const
+{
+    const juce::ScopedLock sl(pathLock);
+    destination = taps[(size_t) tap].publishedPath;
+}
+
+void SpectrumAnalyzer::run()
+{
+    while (! threadShouldExit())
+    {
+        auto analysed = false;
+
+        {
+            const juce::ScopedLock sl(analysisLock);
+
+            for (int tap = 0; tap < numTaps; ++tap)
+                analysed = processTap((Tap) tap) || analysed;
+        }
+
+        // 새 데이터가 없으면 잠깐 쉼 (hop 하나는 48 kHz 에서 약 21 ms)
+        if (! analysed)
+            wait(10);
+    }
+}
+
+bool SpectrumAnalyzer::processTap(Tap tap)
+{
+    auto& state = taps[(size_t) tap];
+    const auto numChannels = state.fifoBuffer.getNumChannels();
+    auto analysed = false;
+
+    while (state.fifo->getNumReady() >= hopSize)
+    {
+        // 오래된 hop 을 밀어내고 새 hop 을 채널 평균으로 붙임
+        auto* time = state.timeBuffer.data();
+        std::memmove(time, time + hopSize, sizeof(float) * (size_t) (fftSize - hopSize));
+
+        auto* destination = time + fftSize - hopSize;
+        const auto scope = state.fifo->read(hopSize);
+        const auto gain = 1.f / (float) numChannels;
+
+        juce::FloatVectorOperations::clear(destination, hopSize);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            juce::FloatVectorOperations::addWithMultiply(destination, state.fifoBuffer.getReadPointer(ch, scope.startIndex1),
+                                                         gain, scope.blockSize1);
+            juce::FloatVectorOperations::addWithMultiply(destination + scope.blockSize1,
+                                                         state.fifoBuffer.getReadPointer(ch, scope.startIndex2),
+                                                         gain, scope.blockSize2);
+        }
+
+        state.numBuffered = juce::jmin(fftSize, state.numBuffered + hopSize);
+
+        if (state.numBuffered == fftSize)
+        {
+            analyseFrame(tap);
+            analysed = true;
+        }
+    }
+
+    return analysed;
+}
+
+void SpectrumAnalyzer::analyseFrame(Tap tap)
+{
+    auto& state = taps[(size_t) tap];
+
+    std::copy(state.timeBuffer.begin(), state.timeBuffer.end(), fftData.begin());
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    // 사인파의 진폭이 0 dB 가 되도록 정규화 (한쪽 스펙트럼 2 / N, 해닝 창의 이득 0.5)
+    const auto scale = 4.f / (float) fftSize;
+
+    // 올라갈 때는 바로, 내려갈 때는 천천히 따라감
+    constexpr float release = 0.8f;
+
+    state.workingPath.clear();
+    auto silent = true;
+
+    for (int i = 0; i < numPathPoints; ++i)
+    {
+        const auto bin = pointBins[(size_t) i];
+        const auto index = (int) bin;
+        const auto fraction = bin - (float) index;
+        const auto magnitude = fftData[(size_t) index] + fraction * (fftData[(size_t) index + 1] - fftData[(size_t) index]);
+        const auto decibels = juce::Decibels::gainToDecibels(magnitude * scale, minDecibels);
+
+        auto& level = state.levels[(size_t) i];
+        level = decibels > level ? decibels : level * release + decibels * (1.f - release);
+        silent = silent && level < minDecibels + 0.5f;
+
+        const auto x = (float) i / (float) (numPathPoints - 1);
+        const auto y = juce::jmap(level, minDecibels, maxDecibels, 1.f, 0.f);
+
+        if (i == 0)
+            state.workingPath.startNewSubPath(x, y);
+        else
+            state.workingPath.lineTo(x, y);
+    }
+
+    // 바닥에 붙은 스펙트럼을 계속 발행하면 에디터가 쉬지 못하므로 한 번만 발행
+    if (silent && state.publishedSilence)
+        return;
+
+    state.publishedSilence = silent;
+
+    {
+        const juce::ScopedLock sl(pathLock);
+        std::swap(state.workingPath, state.publishedPath);
+    }
+
+    version.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 17 Oct 2026 10:26:48pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+// EQ 전(pre)과 후(post)의 스펙트럼 분석기
+// 오디오 스레드는 wait-free SPSC FIFO 에 샘플을 복사하기만 하고
+// 윈도잉, FFT, 스무딩, 경로 생성은 백그라운드 스레드 하나가 모든 에디터를 위해 한 번만 수행
+// 메시지 스레드는 완성된 경로를 받아 그리기만 함
+class SpectrumAnalyzer : private juce::Thread
+{
+public:
+    enum Tap
+    {
+        preEQ,
+        postEQ,
+        numTaps
+    };
+
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 4;
+
+    // 경로는 가로 0 ~ 1 (20 Hz ~ 20 kHz, 로그), 세로 0 ~ 1 (maxDecibels ~ minDecibels) 로 정규화
+    static constexpr int numPathPoints = 256;
+    static constexpr float minDecibels = -96.f;
+    static constexpr float maxDecibels = 0.f;
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
+
+    // prepareToPlay 에서 호출, FIFO 와 분석 버퍼를 여기서만 할당
+    void prepare(double sampleRate, int numChannels);
+
+    // 오디오 스레드 전용, 보는 에디터가 없으면 아무것도 하지 않음
+    // 앞의 두 채널만 복사하고, FIFO 가 가득 차면 넘치는 샘플은 버림
+    template <typename SampleType>
+    void push(Tap tap, const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        if (numViewers.load(std::memory_order_relaxed) == 0)
+            return;
+
+        auto& fifo = *taps[(size_t) tap].fifo;
+        auto& buffer = taps[(size_t) tap].fifoBuffer;
+        const auto numChannels = juce::jmin((int) block.getNumChannels(), buffer.getNumChannels());
+
+        if (numChannels == 0)
+            return;
+
+        const auto scope = fifo.write((int) block.getNumSamples());
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* source = block.getChannelPointer((size_t) ch);
+            copySamples(buffer.getWritePointer(ch, scope.startIndex1), source, scope.blockSize1);
+            copySamples(buffer.getWritePointer(ch, scope.startIndex2), source + scope.blockSize1, scope.blockSize2);
+        }
+    }
+
+    // 에디터가 열리고 닫힐 때 호출 (메시지 스레드), 보는 에디터가 있을 때만 스레드가 돎
+    void addViewer();
+    void removeViewer();
+
+    // 메시지 스레드, 마지막으로 완성된 경로를 destination 에 복사
+    void getPath(Tap tap, juce::Path& destination) const;
+
+    // 새 경로가 발행될 때마다 증가, 에디터가 다시 그릴지 판단하는 데 씀
+    juce::uint32 getVersion() const noexcept { return version.load(std::memory_order_acquire); }
+
+private:
+    void run() override;
+
+    // 쌓인 샘플로 hop 단위 분석을 진행, 분석이 한 번이라도 이루어졌으면 true
+    bool processTap(Tap tap);
+    void analyseFrame(Tap tap);
+
+    static void copySamples(float* destination, const float* source, int numSamples) noexcept
+    {
+        juce::FloatVectorOperations::copy(destination, source, numSamples);
+    }
+
+    static void copySamples(float* destination, const double* source, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = (float) source[i];
+    }
+
+    struct TapState
+    {
+        std::unique_ptr<juce::AbstractFifo> fifo;
+        juce::AudioBuffer<float> fifoBuffer;
+
+        // 분석 스레드 전용
+        std::vector<float> timeBuffer, levels;
+        int numBuffered = 0;
+        bool publishedSilence = false;
+        juce::Path workingPath;
+
+        // lock 으로 보호, 분석 스레드가 workingPath 와 맞바꿈
+        juce::Path publishedPath;
+    };
+
+    std::array<TapState, numTaps> taps;
+
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> fftData;
+
+    // 경로의 점마다 대응하는 (소수) 빈 번호, prepare 에서 샘플 레이트로 계산
+    std::array<float, numPathPoints> pointBins {};
+
+    // prepare 와 분석 스레드 사이, 발행된 경로와 메시지 스레드 사이의 보호용 (오디오 스레드는 잡지 않음)
+    juce::CriticalSection analysisLock;
+    mutable juce::CriticalSection pathLock;
+
+    std::atomic<int> numViewers { 0 };
+    std::atomic<juce::uint32> version { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 17 Oct 2026 2:31:08pm
+    Author:  hc
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+
+// 쓰는 스레드 하나, 읽는 스레드 하나를 위한 lock-free 트리플 버퍼
+// 쓰는 쪽은 뒤 버퍼를 채운 뒤 publish, 읽는 쪽은 새 데이터가 있을 때만 앞 버퍼와 인덱스를 맞바꾼다
+// 양쪽 모두 기다리거나 할당하지 않음 (교환은 atomic 인덱스 하나)
+template <typename Type>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // 쓰는 스레드 전용
+    Type& getWriteBuffer() noexcept { return buffers[(size_t) backIndex]; }
+
+    void publish() noexcept
+    {
+        const auto previous = middle.exchange(backIndex | newDataBit, std::memory_order_acq_rel);
+        backIndex = previous & indexMask;
+    }
+
+    // 읽는 스레드 전용, 마지막 acquire 이후 publish 된 것이 없으면 nullptr
+    const Type* acquire() noexcept
+    {
+        if ((middle.load(std::memory_order_acquire) & newDataBit) == 0)
+            return nullptr;
+
+        const auto previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & indexMask;
+
+        return &buffers[(size_t) frontIndex];
+    }
+
+    const Type& getReadBuffer() const noexcept { return buffers[(size_t) frontIndex]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataBit = 4;
+
+    std::array<Type, 3> buffers;
+    std::atomic<int> middle { 1 };
+    int frontIndex = 0, backIndex = 2;
+
+    JUCE_DECLARE_NON_COPYABLE (TripleBuffer)
+};
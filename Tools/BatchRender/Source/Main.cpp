@@ -0,0 +1,371 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 8:14:52pm
+    Author:  hc
+
+    NormalEQAudioProcessor 를 화면 없이 띄워서 오디오 파일을 일괄 처리하는 콘솔 도구
+
+    normalEQBatch --output <폴더> [--preset <파일>] [--param "Peak Gain=6"]...
+                  [--threads <n>] [--block-size <n>] [--double] <입력 파일>...
+    normalEQBatch --build-library <라이브러리 파일> <프리셋 파일>...
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+
+namespace
+{
+
+// 모든 파일이 공유하는 렌더링 설정, 작업이 시작된 뒤에는 읽기만 함
+struct RenderOptions
+{
+    juce::MemoryBlock state;                                    // 프리셋 (비어 있으면 기본값)
+    std::vector<std::pair<juce::String, float>> parameters;     // --param "ID=값", 프리셋 위에 덮어씀
+    juce::File outputDirectory;
+    int blockSize = 512;
+    bool useDoublePrecision = false;
+};
+
+// getStateInformation 으로 저장한 바이너리 상태 또는 같은 ValueTree 의 XML
+bool loadPreset(const juce::File& file, juce::MemoryBlock& state)
+{
+    if (auto xml = juce::parseXML(file))
+    {
+        const auto tree = juce::ValueTree::fromXml(*xml);
+
+        if (! tree.isValid())
+            return false;
+
+        juce::MemoryOutputStream mos(state, false);
+        tree.writeToStream(mos);
+        return true;
+    }
+
+    return file.loadFileAsData(state) && state.getSize() > 0;
+}
+
+// 프리셋 파일들을 하나의 라이브러리로 묶음, 프리셋 이름은 파일 이름
+// 밴드 파라미터만 담아서 프리셋을 바꿔도 오버샘플링 등 처리 설정은 유지됨
+bool buildPresetLibrary(const juce::File& libraryFile, const juce::Array<juce::File>& presetFiles)
+{
+    NormalEQAudioProcessor processor(false);
+
+    std::vector<juce::uint32> keys;
+    std::vector<juce::RangedAudioParameter*> parameters;
+
+    for (auto* param : processor.getParameters())
+    {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param))
+        {
+            if (getBandIndex(ranged->paramID))
+            {
+                keys.push_back(getParameterKey(ranged->paramID));
+                parameters.push_back(ranged);
+            }
+        }
+    }
+
+    juce::StringArray names;
+    std::vector<float> values;
+
+    for (const auto& presetFile : presetFiles)
+    {
+        juce::MemoryBlock state;
+
+        if (! loadPreset(presetFile, state))
+        {
+            std::cerr << "cannot load preset " << presetFile.getFullPathName() << std::endl;
+            return false;
+        }
+
+        processor.setStateInformation(state.getData(), (int) state.getSize());
+        names.add(presetFile.getFileNameWithoutExtension());
+
+        for (auto* parameter : parameters)
+            values.push_back(parameter->convertFrom0to1(parameter->getValue()));
+    }
+
+    return PresetLibrary::write(libraryFile, keys, names, values);
+}
+
+// WAV, AIFF 는 메모리 맵으로 읽고, 그 밖의 형식(FLAC 등)은 스트리밍으로 읽음
+std::unique_ptr<juce::AudioFormatReader> createReader(juce::AudioFormatManager& formatManager, const juce::File& file)
+{
+    if (auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+    {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+        if (mapped != nullptr && mapped->mapEntireFile())
+            return mapped;
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+}
+
+std::unique_ptr<juce::AudioFormatWriter> createWriter(juce::AudioFormatManager& formatManager, const juce::File& file,
+                                                      const juce::AudioFormatReader& reader)
+{
+    auto* format = formatManager.findFormatForFileExtension(file.getFileExtension());
+
+    if (format == nullptr || ! file.deleteFile())
+        return nullptr;
+
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+
+    if (stream->failedToOpen())
+        return nullptr;
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), reader.sampleRate,
+                                                                            reader.numChannels, (int) reader.bitsPerSample,
+                                                                            reader.metadataValues, 0));
+
+    // 성공하면 writer 가 스트림을 가져감
+    if (writer != nullptr)
+        stream.release();
+
+    return writer;
+}
+
+// 파일 하나를 처음부터 끝까지 처리, 실패하면 이유를 반환
+// 파일마다 프로세서를 새로 만들기 때문에 결과는 스레드 수나 처리 순서와 상관없이 같다
+template <typename SampleType>
+juce::String renderFile(const juce::File& input, const RenderOptions& options)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto reader = createReader(formatManager, input);
+
+    if (reader == nullptr)
+        return "cannot read file";
+
+    const auto numChannels = (int) reader->numChannels;
+    const auto sampleRate = reader->sampleRate;
+    const auto length = reader->lengthInSamples;
+
+    // 사용자 프리셋 라이브러리와 무관하게, 설계와 커널 로드는 처리 스레드에서 동기로 하도록 오프라인으로 둠
+    NormalEQAudioProcessor processor(false);
+    processor.setNonRealtime(true);
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+    layout.outputBuses.add(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+
+    if (! processor.setBusesLayout(layout))
+        return "unsupported channel count " + juce::String(numChannels);
+
+    processor.setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision
+                                                                        : juce::AudioProcessor::singlePrecision);
+
+    if (options.state.getSize() > 0)
+        processor.setStateInformation(options.state.getData(), (int) options.state.getSize());
+
+    for (const auto& [parameterID, value] : options.parameters)
+    {
+        auto* parameter = processor.apvts.getParameter(parameterID);
+
+        if (parameter == nullptr)
+            return "unknown parameter " + parameterID;
+
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    // 파라미터를 모두 정한 뒤에 준비해야 prepareToPlay 에서 한 번에 설계됨
+    processor.setRateAndBufferSizeDetails(sampleRate, options.blockSize);
+    processor.prepareToPlay(sampleRate, options.blockSize);
+
+    const auto outputFile = options.outputDirectory.getChildFile(input.getFileName());
+    auto writer = createWriter(formatManager, outputFile, *reader);
+
+    if (writer == nullptr)
+        return "cannot write " + outputFile.getFullPathName();
+
+    // 지연만큼 더 처리하고 앞부분을 버려서 입력과 시간이 맞는 같은 길이의 출력을 만듦
+    const auto latency = (juce::int64) processor.getLatencySamples();
+    const auto totalSamples = length + latency;
+
+    juce::AudioBuffer<float> ioBuffer(numChannels, options.blockSize);
+    juce::AudioBuffer<SampleType> processBuffer(numChannels, options.blockSize);
+    juce::MidiBuffer midi;
+
+    for (juce::int64 position = 0; position < totalSamples; position += options.blockSize)
+    {
+        const auto numSamples = (int) juce::jmin((juce::int64) options.blockSize, totalSamples - position);
+
+        // 파일 끝을 넘어선 부분은 0 으로 채워짐
+        reader->read(&ioBuffer, 0, numSamples, position, true, true);
+
+        juce::AudioBuffer<SampleType> block(processBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+        if constexpr (std::is_same_v<SampleType, float>)
+            for (int ch = 0; ch < numChannels; ++ch)
+                block.copyFrom(ch, 0, ioBuffer, ch, 0, numSamples);
+        else
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    block.setSample(ch, i, (double) ioBuffer.getSample(ch, i));
+
+        processor.processBlock(block, midi);
+
+        const auto skip = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, latency - position);
+        const auto numToWrite = numSamples - skip;
+
+        if (numToWrite <= 0)
+            continue;
+
+        if constexpr (std::is_same_v<SampleType, float>)
+            for (int ch = 0; ch < numChannels; ++ch)
+                ioBuffer.copyFrom(ch, 0, block, ch, skip, numToWrite);
+        else
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numToWrite; ++i)
+                    ioBuffer.setSample(ch, i, (float) block.getSample(ch, skip + i));
+
+        if (! writer->writeFromAudioSampleBuffer(ioBuffer, 0, numToWrite))
+            return "write failed";
+    }
+
+    processor.releaseResources();
+    return {};
+}
+
+void printUsage()
+{
+    std::cout << "usage: normalEQBatch --output <dir> [--preset <file>] [--param \"ID=value\"]..." << std::endl
+              << "                     [--threads <n>] [--block-size <n>] [--double] <input files>..." << std::endl
+              << "       normalEQBatch --build-library <library file> <preset files>..." << std::endl;
+}
+
+} // namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // APVTS 의 타이머 등이 메시지 매니저를 필요로 함 (메시지 루프는 돌리지 않음)
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    RenderOptions options;
+    juce::Array<juce::File> inputs;
+    juce::File libraryFile;
+    auto numThreads = juce::SystemStats::getNumCpus();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String argument(argv[i]);
+        const auto hasValue = i + 1 < argc;
+
+        if (argument == "--output" && hasValue)
+        {
+            options.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        }
+        else if (argument == "--preset" && hasValue)
+        {
+            const auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+
+            if (! loadPreset(presetFile, options.state))
+            {
+                std::cerr << "cannot load preset " << presetFile.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+        else if (argument == "--param" && hasValue)
+        {
+            const juce::String assignment(argv[++i]);
+            options.parameters.emplace_back(assignment.upToFirstOccurrenceOf("=", false, false).trim(),
+                                            assignment.fromFirstOccurrenceOf("=", false, false).getFloatValue());
+        }
+        else if (argument == "--threads" && hasValue)
+        {
+            numThreads = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        }
+        else if (argument == "--block-size" && hasValue)
+        {
+            options.blockSize = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        }
+        else if (argument == "--build-library" && hasValue)
+        {
+            libraryFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        }
+        else if (argument == "--double")
+        {
+            options.useDoublePrecision = true;
+        }
+        else if (argument.startsWith("--"))
+        {
+            printUsage();
+            return 1;
+        }
+        else
+        {
+            inputs.add(juce::File::getCurrentWorkingDirectory().getChildFile(argument));
+        }
+    }
+
+    // 라이브러리를 만들 때는 입력이 오디오 파일이 아니라 프리셋 파일
+    if (libraryFile != juce::File() && ! inputs.isEmpty())
+    {
+        if (! buildPresetLibrary(libraryFile, inputs))
+        {
+            std::cerr << "cannot write " << libraryFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::cout << "wrote   " << libraryFile.getFullPathName() << " (" << inputs.size() << " presets)" << std::endl;
+        return 0;
+    }
+
+    if (inputs.isEmpty() || options.outputDirectory == juce::File())
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (! options.outputDirectory.createDirectory())
+    {
+        std::cerr << "cannot create " << options.outputDirectory.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    // 파일 단위로 나눠서 병렬 처리, 결과는 파일 순서대로 모아서 출력
+    std::vector<juce::String> errors((size_t) inputs.size());
+
+    {
+        juce::ThreadPool pool(juce::jmin(numThreads, inputs.size()));
+
+        for (int i = 0; i < inputs.size(); ++i)
+        {
+            pool.addJob([&options, &errors, input = inputs[i], i]
+            {
+                errors[(size_t) i] = options.useDoublePrecision ? renderFile<double>(input, options)
+                                                                : renderFile<float>(input, options);
+                return juce::ThreadPoolJob::jobHasFinished;
+            });
+        }
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+    }
+
+    auto numFailed = 0;
+
+    for (int i = 0; i < inputs.size(); ++i)
+    {
+        const auto& error = errors[(size_t) i];
+
+        if (error.isEmpty())
+        {
+            std::cout << "ok      " << inputs[i].getFullPathName() << std::endl;
+        }
+        else
+        {
+            std::cerr << "failed  " << inputs[i].getFullPathName() << ": " << error << std::endl;
+            ++numFailed;
+        }
+    }
+
+    return numFailed == 0 ? 0 : 1;
+}
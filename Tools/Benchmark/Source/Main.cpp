@@ -0,0 +1,893 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 9:02:37pm
+    Author:  hc
+
+    DSP 경로 마이크로벤치마크
+
+    normalEQBenchmark [--output <json>] [--baseline <json>] [--tolerance <0.1>]
+                      [--filter <이름 일부>] [--seconds <0.5>] [--double] [--full]
+
+    processBlock 은 기본으로 48 kHz, 블록 64 / 1024, 기울기 12 / 48 dB 만 잼 (리뷰에서 돌릴 수 있는 길이)
+    --full 이면 샘플 레이트, 블록 크기, 기울기 조합 전체를 잼 (수십 분 걸림)
+
+    처리 시간은 채널 하나의 샘플 하나당 ns ("sample"), 설계 함수는 호출 한 번당 ns ("call")
+    에디터는 여는 것 한 번당 ns ("editor")
+    할당 수와 할당된 바이트는 호출(처리는 블록) 한 번당 평균, 측정하는 스레드에서 일어난 것만 셈
+    시작할 때 BiquadDesign.h 의 계수를 JUCE 설계와 비교, 차이가 1e-9 를 넘으면 종료 코드 3
+    Side 에만 배치한 밴드의 SVF 엔진 출력이 바이쿼드 엔진과 1e-6 넘게 달라도 종료 코드 3
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "../../../Source/AbletonStyleBox.h"
+
+//==============================================================================
+// 전역 new 를 바꿔서 이 스레드에서 일어난 할당만 셈 (설계 스레드의 할당은 제외)
+namespace
+{
+    thread_local juce::int64 allocationCount = 0;
+    thread_local juce::int64 allocatedBytes = 0;
+}
+
+void* operator new (std::size_t size)
+{
+    ++allocationCount;
+    allocatedBytes += (juce::int64) size;
+
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)                  { return operator new (size); }
+void operator delete (void* ptr) noexcept                { std::free(ptr); }
+void operator delete[] (void* ptr) noexcept              { std::free(ptr); }
+void operator delete (void* ptr, std::size_t) noexcept   { std::free(ptr); }
+void operator delete[] (void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+
+struct Options
+{
+    juce::String filter;
+    double seconds = 0.5;
+    int numRuns = 5;
+    bool includeDouble = false;
+    bool fullSweep = false;
+};
+
+struct Result
+{
+    juce::String name, unit;
+    double nanoseconds = 0.0;
+    double allocationsPerCall = 0.0;
+    double bytesPerCall = 0.0;
+};
+
+// 최적화로 설계 결과가 사라지지 않도록 여기에 더해 둠
+volatile double sink = 0.0;
+
+// 워밍업 한 번 후 numRuns 번 반복해서 중앙값을 씀, body(i) 는 i 번째 호출
+template <typename Body>
+Result measure(const juce::String& name, const juce::String& unit, int unitsPerCall, int numCalls,
+               const Options& options, Body&& body)
+{
+    for (int i = 0; i < numCalls; ++i)
+        body(i);
+
+    std::vector<double> runs;
+    juce::int64 allocations = 0, bytes = 0;
+
+    for (int run = 0; run < options.numRuns; ++run)
+    {
+        const auto allocationsBefore = allocationCount;
+        const auto bytesBefore = allocatedBytes;
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numCalls; ++i)
+            body(i);
+
+        const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        allocations += allocationCount - allocationsBefore;
+        bytes += allocatedBytes - bytesBefore;
+        runs.push_back(elapsed * 1.0e9 / ((double) unitsPerCall * numCalls));
+    }
+
+    std::sort(runs.begin(), runs.end());
+
+    const auto totalCalls = (double) options.numRuns * numCalls;
+    return { name, unit, runs[runs.size() / 2], (double) allocations / totalCalls, (double) bytes / totalCalls };
+}
+
+int getSlopeDecibels(Slope slope) { return 12 * ((int) slope + 1); }
+
+// 로우컷/피크/하이컷이 모두 동작하는 기본 설정
+ChainSettings makeDefaultSettings(Slope lowCutSlope = Slope_48, Slope highCutSlope = Slope_48)
+{
+    ChainSettings settings;
+    settings.lowCutFreq = 120.f;
+    settings.highCutFreq = 8000.f;
+    settings.peakFreq = 1000.f;
+    settings.peakGainInDecibels = 6.f;
+    settings.peakQuality = 1.f;
+    settings.lowCutSlope = lowCutSlope;
+    settings.highCutSlope = highCutSlope;
+    return settings;
+}
+
+// 활성 밴드가 numActiveBands 개인 설정 (피크 -> 로우컷 -> 하이컷 -> 추가 밴드 순서로 켬)
+ChainSettings makeBandSettings(int numActiveBands)
+{
+    jassert(numActiveBands >= 1 && numActiveBands <= numBands);
+
+    ChainSettings settings;
+    settings.lowCutFreq = 20.f;
+    settings.highCutFreq = 20000.f;
+    settings.peakFreq = 1000.f;
+    settings.peakGainInDecibels = 6.f;
+
+    if (numActiveBands >= 2)
+        settings.lowCutFreq = 80.f;
+
+    if (numActiveBands >= 3)
+        settings.highCutFreq = 12000.f;
+
+    for (int i = 0; i < numActiveBands - firstExtraBand; ++i)
+    {
+        settings.bands.type[(size_t) i] = BandType_Peak;
+        settings.bands.freq[(size_t) i] = 100.f * std::pow(2.f, (float) i * 0.4f);
+        settings.bands.gainInDecibels[(size_t) i] = (i % 2 == 0) ? 3.f : -3.f;
+        settings.bands.quality[(size_t) i] = 1.f;
+    }
+
+    return settings;
+}
+
+// 재현 가능한 잡음, 처리 결과가 무음 건너뛰기에 걸리지 않도록
+template <typename SampleType>
+void fillNoise(juce::AudioBuffer<SampleType>& buffer)
+{
+    juce::Random random(0x6e45);
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(ch, i, (SampleType) (random.nextFloat() * 2.f - 1.f) * SampleType(0.25));
+}
+
+int getNumCalls(double sampleRate, int blockSize, const Options& options)
+{
+    return juce::jmax(1, (int) (sampleRate * options.seconds) / blockSize);
+}
+
+void setParameter(NormalEQAudioProcessor& processor, ParameterIndex parameterIndex, float value)
+{
+    auto& parameter = processor.getParameterHandles().getParameter(parameterIndex);
+    parameter.setValueNotifyingHost(parameter.convertTo0to1(value));
+}
+
+//==============================================================================
+// 프로세서 전체: 정적인 파라미터, 자동화(설계 스레드), 스무딩 중 자동화(오디오 스레드에서 updateFilters)
+// MIDI CC 스윕(32 샘플마다 이벤트, 블록을 나누고 오디오 스레드에서 설계)
+enum class Automation
+{
+    none,
+    automated,
+    smoothed,
+    midi
+};
+
+template <typename SampleType>
+Result benchmarkProcessBlock(double sampleRate, int blockSize, Slope lowCutSlope, Slope highCutSlope,
+                             Automation automation, const juce::String& name, const Options& options)
+{
+    constexpr int numChannels = 2;
+
+    NormalEQAudioProcessor processor;
+    processor.setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision
+                                                                        : juce::AudioProcessor::singlePrecision);
+
+    const auto settings = makeDefaultSettings(lowCutSlope, highCutSlope);
+    setParameter(processor, Parameter_LowCutFreq, settings.lowCutFreq);
+    setParameter(processor, Parameter_HighCutFreq, settings.highCutFreq);
+    setParameter(processor, Parameter_PeakFreq, settings.peakFreq);
+    setParameter(processor, Parameter_PeakGain, settings.peakGainInDecibels);
+    setParameter(processor, Parameter_LowCutSlope, (float) lowCutSlope);
+    setParameter(processor, Parameter_HighCutSlope, (float) highCutSlope);
+    setParameter(processor, Parameter_Smoothing, automation == Automation::smoothed ? 2.f : 0.f);
+
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    const auto numCalls = getNumCalls(sampleRate, blockSize, options);
+
+    // 처리는 제자리에서 이루어지므로 매 블록 원본 잡음을 복사해서 넣음 (복사 비용도 측정에 포함)
+    juce::AudioBuffer<SampleType> source(numChannels, blockSize * numCalls);
+    juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+    juce::MidiBuffer midi;
+    fillNoise(source);
+
+    const auto& parameters = processor.getParameterHandles();
+    auto* lowCutFreq = &parameters.getParameter(Parameter_LowCutFreq);
+    auto* peakFreq = &parameters.getParameter(Parameter_PeakFreq);
+    auto* peakGain = &parameters.getParameter(Parameter_PeakGain);
+    auto* highCutFreq = &parameters.getParameter(Parameter_HighCutFreq);
+
+    // 버퍼 용량을 미리 잡아 두어 측정 중에 할당하지 않음
+    constexpr int midiInterval = 32;
+    midi.ensureSize((size_t) (blockSize / midiInterval + 1) * 16);
+
+    auto result = measure(name, "sample", blockSize * numChannels, numCalls, options, [&](int call)
+    {
+        if (automation == Automation::midi)
+        {
+            // Peak Freq (CC 16) 를 0 ~ 127 사이에서 계속 오르내림
+            midi.clear();
+
+            for (int position = 0; position < blockSize; position += midiInterval)
+            {
+                const auto step = (call * blockSize + position) / midiInterval;
+                const auto value = std::abs(step % 254 - 127);
+                midi.addEvent(juce::MidiMessage::controllerEvent(1, 16, value), position);
+            }
+        }
+        else if (automation != Automation::none)
+        {
+            // 호스트 자동화처럼 블록마다 주파수와 게인을 천천히 흔듦 (약 0.5 Hz)
+            const auto phase = (float) std::sin(juce::MathConstants<double>::twoPi * 0.5 * call * blockSize / sampleRate);
+            const auto normalised = 0.5f + 0.25f * phase;
+
+            lowCutFreq->setValueNotifyingHost(normalised * 0.5f);
+            peakFreq->setValueNotifyingHost(normalised);
+            peakGain->setValueNotifyingHost(normalised);
+            highCutFreq->setValueNotifyingHost(0.5f + normalised * 0.5f);
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, 0, source, ch, call * blockSize, blockSize);
+
+        processor.processBlock(buffer, midi);
+    });
+
+    processor.releaseResources();
+    return result;
+}
+
+void runProcessBlockBenchmarks(std::vector<Result>& results, const Options& options)
+{
+    // 기본은 짧은 대표 조합, 이름은 전체 조합과 같으므로 같은 기준 파일로 비교할 수 있음
+    const auto sampleRates = options.fullSweep ? std::vector<double> { 44100.0, 48000.0, 96000.0, 192000.0 }
+                                               : std::vector<double> { 48000.0 };
+    const auto blockSizes = options.fullSweep ? std::vector<int> { 1, 16, 64, 256, 1024, 4096 }
+                                              : std::vector<int> { 64, 1024 };
+    const auto slopes = options.fullSweep ? std::vector<Slope> { Slope_12, Slope_24, Slope_36, Slope_48 }
+                                          : std::vector<Slope> { Slope_12, Slope_48 };
+    const std::pair<Automation, const char*> automations[] = { { Automation::none, "static" },
+                                                               { Automation::automated, "automated" },
+                                                               { Automation::smoothed, "smoothed" },
+                                                               { Automation::midi, "midi" } };
+
+    for (auto precision : { 0, 1 })
+    {
+        if (precision == 1 && ! options.includeDouble)
+            continue;
+
+        for (auto sampleRate : sampleRates)
+            for (auto blockSize : blockSizes)
+                for (auto lowCutSlope : slopes)
+                    for (auto highCutSlope : slopes)
+                        for (const auto& [automation, automationName] : automations)
+                        {
+                            // 기본 조합에서는 두 기울기가 같은 경우만
+                            if (! options.fullSweep && lowCutSlope != highCutSlope)
+                                continue;
+
+                            const auto name = juce::String("processBlock/") + (precision == 1 ? "double" : "float")
+                                            + "/" + juce::String((int) sampleRate) + "/" + juce::String(blockSize)
+                                            + "/lc" + juce::String(getSlopeDecibels(lowCutSlope))
+                                            + "-hc" + juce::String(getSlopeDecibels(highCutSlope))
+                                            + "/" + automationName;
+
+                            if (! name.contains(options.filter))
+                                continue;
+
+                            results.push_back(precision == 1
+                                ? benchmarkProcessBlock<double>(sampleRate, blockSize, lowCutSlope, highCutSlope, automation, name, options)
+                                : benchmarkProcessBlock<float>(sampleRate, blockSize, lowCutSlope, highCutSlope, automation, name, options));
+                        }
+    }
+}
+
+//==============================================================================
+// 설계 함수들, 호출 한 번당 시간과 할당 수
+void runDesignBenchmarks(std::vector<Result>& results, const Options& options)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numCalls = 10000;
+
+    auto add = [&](const juce::String& name, auto&& body)
+    {
+        if (name.contains(options.filter))
+            results.push_back(measure(name, "call", 1, numCalls, options, body));
+    };
+
+    NormalEQAudioProcessor processor;
+
+    add("design/getChainSettings", [&](int)
+    {
+        sink = sink + getChainSettings(processor.getParameterHandles()).peakFreq;
+    });
+
+    for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+    {
+        const auto settings = makeDefaultSettings(slope, slope);
+        const auto suffix = "/" + juce::String(getSlopeDecibels(slope));
+
+        add("design/makeLowCutFilter" + suffix, [&](int)
+        {
+            sink = sink + makeLowCutFilter(settings, sampleRate)[0]->coefficients[0];
+        });
+
+        add("design/makeHighCutFilter" + suffix, [&](int)
+        {
+            sink = sink + makeHighCutFilter(settings, sampleRate)[0]->coefficients[0];
+        });
+
+        add("design/designLowCutSections/biquad" + suffix, [&](int)
+        {
+            std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+            sink = sink + designLowCutSections(settings, sampleRate, sections);
+        });
+
+        add("design/designLowCutSections/svf" + suffix, [&](int)
+        {
+            std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+            sink = sink + designLowCutSections(settings, sampleRate, sections);
+        });
+
+        add("design/designHighCutSections/biquad" + suffix, [&](int)
+        {
+            std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+            sink = sink + designHighCutSections(settings, sampleRate, sections);
+        });
+
+        add("design/designHighCutSections/svf" + suffix, [&](int)
+        {
+            std::array<SVFCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+            sink = sink + designHighCutSections(settings, sampleRate, sections);
+        });
+    }
+
+    const auto settings = makeBandSettings(numBands);
+
+    add("design/makePeakFilter", [&](int)
+    {
+        sink = sink + makePeakFilter(settings, sampleRate)->coefficients[0];
+    });
+
+    add("design/designPeakSection/biquad", [&](int)
+    {
+        sink = sink + designPeakSection(settings, sampleRate).b0;
+    });
+
+    add("design/designPeakSection/svf", [&](int)
+    {
+        sink = sink + designPeakSVFSection(settings, sampleRate).g;
+    });
+
+    add("design/designBandSection/biquad", [&](int call)
+    {
+        sink = sink + designBandSection(settings, call % numExtraBands, sampleRate).b0;
+    });
+
+    add("design/designBandSection/svf", [&](int call)
+    {
+        sink = sink + designBandSVFSection(settings, call % numExtraBands, sampleRate).g;
+    });
+}
+
+//==============================================================================
+// 에디터를 여는 시간과 그동안 할당된 바이트 (에디터가 차지하는 메모리의 상한)
+// 다른 에디터가 열려 있으면 폰트, 룩앤필, 아이콘은 이미 만들어져 있으므로 따로 잼
+void runEditorBenchmarks(std::vector<Result>& results, const Options& options)
+{
+    constexpr int numCalls = 20;
+    constexpr int numInstances = 200;
+
+    auto add = [&](const juce::String& name, auto&& run)
+    {
+        if (name.contains(options.filter))
+            results.push_back(run(name));
+    };
+
+    add("editor/open", [&](const juce::String& name)
+    {
+        NormalEQAudioProcessor processor;
+
+        return measure(name, "editor", 1, numCalls, options, [&](int)
+        {
+            std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+        });
+    });
+
+    add("editor/open/shared", [&](const juce::String& name)
+    {
+        NormalEQAudioProcessor processor;
+        juce::SharedResourcePointer<SharedEditorResources> openEditorResources;
+        openEditorResources->getLookAndFeel();
+
+        return measure(name, "editor", 1, numCalls, options, [&](int)
+        {
+            std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+        });
+    });
+
+    // 세션의 모든 인스턴스가 에디터를 연 상태, 한 호출에서 모두 열고 닫음
+    add("editor/open/" + juce::String(numInstances) + "-instances", [&](const juce::String& name)
+    {
+        std::vector<std::unique_ptr<NormalEQAudioProcessor>> processors;
+
+        for (int i = 0; i < numInstances; ++i)
+            processors.push_back(std::make_unique<NormalEQAudioProcessor>());
+
+        std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors;
+        editors.reserve((size_t) numInstances);
+
+        return measure(name, "editor", numInstances, 1, options, [&](int)
+        {
+            for (auto& processor : processors)
+                editors.emplace_back(processor->createEditor());
+
+            editors.clear();
+        });
+    });
+}
+
+//==============================================================================
+// BiquadDesign.h 의 설계와 JUCE 설계의 계수 차이, 계수 크기가 1 보다 크면 상대 오차
+constexpr double designTolerance = 1.0e-9;
+
+double getCoefficientError(const BiquadCoefficients<double>& designed, const juce::dsp::IIR::Coefficients<double>& reference)
+{
+    const auto expected = toBiquadCoefficients(reference);
+    const std::array<std::pair<double, double>, 5> pairs {{ { designed.b0, expected.b0 }, { designed.b1, expected.b1 },
+                                                           { designed.b2, expected.b2 }, { designed.a1, expected.a1 },
+                                                           { designed.a2, expected.a2 } }};
+    auto error = 0.0;
+
+    for (const auto& [value, expectedValue] : pairs)
+        error = juce::jmax(error, std::abs(value - expectedValue) / juce::jmax(1.0, std::abs(expectedValue)));
+
+    return error;
+}
+
+// 주파수, 기울기, 이득, Q 를 훑으며 가장 큰 차이를 반환
+double checkDesignAccuracy()
+{
+    using Coefficients = juce::dsp::IIR::Coefficients<double>;
+
+    auto maxError = 0.0;
+    std::array<BiquadCoefficients<double>, SIMDFilterEngine<double>::maxCutSections> sections;
+
+    for (auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        for (auto frequency : { 20.0, 63.0, 250.0, 1000.0, 4000.0, 12000.0, 19000.0 })
+        {
+            for (int order = 1; order <= ButterworthPoles::maxOrder; ++order)
+            {
+                for (auto isHighPass : { true, false })
+                {
+                    const auto reference = isHighPass
+                        ? juce::dsp::FilterDesign<double>::designIIRHighpassHighOrderButterworthMethod(frequency, sampleRate, order)
+                        : juce::dsp::FilterDesign<double>::designIIRLowpassHighOrderButterworthMethod(frequency, sampleRate, order);
+
+                    const auto numSections = makeBiquadButterworth(isHighPass, frequency, order, sampleRate,
+                                                                   sections.data(), (int) sections.size());
+                    jassert(numSections == reference.size());
+
+                    for (int i = 0; i < numSections; ++i)
+                        maxError = juce::jmax(maxError, getCoefficientError(sections[(size_t) i], *reference.getUnchecked(i)));
+                }
+            }
+
+            for (auto quality : { 0.1, 0.707, 1.0, 4.0, 10.0 })
+            {
+                maxError = juce::jmax(maxError, getCoefficientError(makeBiquadNotch<double>(frequency, quality, sampleRate),
+                                                                    *Coefficients::makeNotch(sampleRate, frequency, quality)));
+
+                for (auto gainInDecibels : { -24.0, -6.0, 0.5, 6.0, 24.0 })
+                {
+                    const auto gain = juce::Decibels::decibelsToGain(gainInDecibels);
+
+                    maxError = juce::jmax(maxError, getCoefficientError(makeBiquadPeak<double>(frequency, quality, gain, sampleRate),
+                                                                        *Coefficients::makePeakFilter(sampleRate, frequency, quality, gain)));
+                    maxError = juce::jmax(maxError, getCoefficientError(makeBiquadLowShelf<double>(frequency, quality, gain, sampleRate),
+                                                                        *Coefficients::makeLowShelf(sampleRate, frequency, quality, gain)));
+                    maxError = juce::jmax(maxError, getCoefficientError(makeBiquadHighShelf<double>(frequency, quality, gain, sampleRate),
+                                                                        *Coefficients::makeHighShelf(sampleRate, frequency, quality, gain)));
+                }
+            }
+        }
+    }
+
+    return maxError;
+}
+
+//==============================================================================
+// Mid/Side 에서 Side 레인에만 배치한 로우컷, 피크, 하이컷을 두 엔진으로 처리한 출력의 차이
+// 레인마다 계수가 다르므로 SVF 엔진이 레인별로 계수를 계산하는지 확인함
+constexpr double engineTolerance = 1.0e-6;
+
+template <typename EngineType, typename SectionType>
+juce::AudioBuffer<double> renderSidePlaced(const ChainSettings& settings, double sampleRate, int blockSize, int numBlocks)
+{
+    constexpr auto sideLane = SIMDFilterEngine<double>::sideLane;
+
+    EngineType engine;
+    engine.prepare({ sampleRate, (juce::uint32) blockSize, 2 });
+    engine.setMidSide(true);
+
+    std::array<SectionType, SIMDFilterEngine<double>::maxCutSections> cut;
+    engine.setLowCut(cut.data(), designLowCutSections(settings, sampleRate, cut), 0, sideLane);
+    engine.setHighCut(cut.data(), designHighCutSections(settings, sampleRate, cut), 0, sideLane);
+
+    if constexpr (std::is_same_v<SectionType, SVFCoefficients<double>>)
+        engine.setPeak(designPeakSVFSection(settings, sampleRate), 0, sideLane);
+    else
+        engine.setPeak(designPeakSection(settings, sampleRate), 0, sideLane);
+
+    juce::AudioBuffer<double> buffer(2, blockSize * numBlocks);
+    fillNoise(buffer);
+
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        juce::dsp::AudioBlock<double> block(buffer.getArrayOfWritePointers(), 2, (size_t) (i * blockSize), (size_t) blockSize);
+        engine.process(juce::dsp::ProcessContextReplacing<double>(block));
+    }
+
+    return buffer;
+}
+
+double checkSidePlacedEngines()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512, numBlocks = 16;
+
+    auto maxError = 0.0;
+
+    for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+    {
+        const auto settings = makeDefaultSettings(slope, slope);
+        const auto biquad = renderSidePlaced<SIMDFilterEngine<double>, BiquadCoefficients<double>>(settings, sampleRate, blockSize, numBlocks);
+        const auto svf = renderSidePlaced<SVFFilterEngine<double>, SVFCoefficients<double>>(settings, sampleRate, blockSize, numBlocks);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < biquad.getNumSamples(); ++i)
+                maxError = juce::jmax(maxError, std::abs(biquad.getSample(ch, i) - svf.getSample(ch, i)));
+    }
+
+    return maxError;
+}
+
+//==============================================================================
+// 필터 엔진 단독: MonoChain 과의 비교, 채널 수, 활성 밴드 수
+template <typename EngineType, typename SectionType>
+void loadSections(EngineType& engine, const ChainSettings& settings, double sampleRate)
+{
+    std::array<SectionType, SIMDFilterEngine<double>::maxCutSections> cut;
+
+    engine.setLowCut(cut.data(), designLowCutSections(settings, sampleRate, cut));
+    engine.setHighCut(cut.data(), designHighCutSections(settings, sampleRate, cut));
+
+    if constexpr (std::is_same_v<SectionType, SVFCoefficients<double>>)
+    {
+        engine.setPeak(designPeakSVFSection(settings, sampleRate));
+
+        for (int band = 0; band < numExtraBands; ++band)
+            engine.setBand(band, designBandSVFSection(settings, band, sampleRate));
+    }
+    else
+    {
+        engine.setPeak(designPeakSection(settings, sampleRate));
+
+        for (int band = 0; band < numExtraBands; ++band)
+            engine.setBand(band, designBandSection(settings, band, sampleRate));
+    }
+}
+
+template <typename SampleType, typename EngineType, typename SectionType>
+Result benchmarkEngine(const juce::String& name, int numChannels, const ChainSettings& settings, const Options& options,
+                       bool midSide = false)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    EngineType engine;
+    engine.prepare({ sampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels });
+    engine.setMidSide(midSide);
+    loadSections<EngineType, SectionType>(engine, settings, sampleRate);
+
+    const auto numCalls = getNumCalls(sampleRate, blockSize, options);
+
+    juce::AudioBuffer<SampleType> source(numChannels, blockSize * numCalls);
+    juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+    fillNoise(source);
+
+    return measure(name, "sample", blockSize * numChannels, numCalls, options, [&](int call)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, 0, source, ch, call * blockSize, blockSize);
+
+        juce::dsp::AudioBlock<SampleType> block(buffer);
+        engine.process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+    });
+}
+
+// SIMD 엔진 이전의 처리 방식, 채널마다 MonoChain 하나
+Result benchmarkMonoChain(const juce::String& name, const ChainSettings& settings, const Options& options)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int numChannels = 2;
+
+    std::array<MonoChain, numChannels> chains;
+
+    for (auto& chain : chains)
+    {
+        chain.prepare({ sampleRate, (juce::uint32) blockSize, 1 });
+        updateCutFilter(chain.get<ChainPosition::LowCut>(), makeLowCutFilter(settings, sampleRate), settings.lowCutSlope);
+        updateCoefficients(chain.get<ChainPosition::Peak>().coefficients, makePeakFilter(settings, sampleRate));
+        updateCutFilter(chain.get<ChainPosition::HighCut>(), makeHighCutFilter(settings, sampleRate), settings.highCutSlope);
+    }
+
+    const auto numCalls = getNumCalls(sampleRate, blockSize, options);
+
+    juce::AudioBuffer<float> source(numChannels, blockSize * numCalls);
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    fillNoise(source);
+
+    return measure(name, "sample", blockSize * numChannels, numCalls, options, [&](int call)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, 0, source, ch, call * blockSize, blockSize);
+
+        juce::dsp::AudioBlock<float> block(buffer);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto channelBlock = block.getSingleChannelBlock((size_t) ch);
+            chains[(size_t) ch].process(juce::dsp::ProcessContextReplacing<float>(channelBlock));
+        }
+    });
+}
+
+void runEngineBenchmarks(std::vector<Result>& results, const Options& options)
+{
+    auto add = [&](const juce::String& name, auto&& run)
+    {
+        if (name.contains(options.filter))
+            results.push_back(run(name));
+    };
+
+    const auto settings = makeDefaultSettings();
+
+    add("engine/stereo/monoChain", [&](const juce::String& name)
+    {
+        return benchmarkMonoChain(name, settings, options);
+    });
+
+    add("engine/stereo/simd", [&](const juce::String& name)
+    {
+        return benchmarkEngine<float, SIMDFilterEngine<float>, BiquadCoefficients<double>>(name, 2, settings, options);
+    });
+
+    // 같은 섹션 수의 Mid/Side, 변환은 레인에 옮겨 담는 복사 안에서 이루어지므로 stereo/simd 와 같아야 함
+    add("engine/stereo/simd-midside", [&](const juce::String& name)
+    {
+        return benchmarkEngine<float, SIMDFilterEngine<float>, BiquadCoefficients<double>>(name, 2, settings, options, true);
+    });
+
+    for (auto numChannels : { 2, 6, 12, 16 })
+    {
+        add("engine/channels/biquad/" + juce::String(numChannels), [&](const juce::String& name)
+        {
+            return benchmarkEngine<float, SIMDFilterEngine<float>, BiquadCoefficients<double>>(name, numChannels, settings, options);
+        });
+
+        add("engine/channels/svf/" + juce::String(numChannels), [&](const juce::String& name)
+        {
+            return benchmarkEngine<float, SVFFilterEngine<float>, SVFCoefficients<double>>(name, numChannels, settings, options);
+        });
+    }
+
+    for (auto numActiveBands : { 1, 8, 24 })
+    {
+        const auto bandSettings = makeBandSettings(numActiveBands);
+
+        add("engine/bands/biquad/" + juce::String(numActiveBands), [&](const juce::String& name)
+        {
+            return benchmarkEngine<float, SIMDFilterEngine<float>, BiquadCoefficients<double>>(name, 2, bandSettings, options);
+        });
+
+        add("engine/bands/svf/" + juce::String(numActiveBands), [&](const juce::String& name)
+        {
+            return benchmarkEngine<float, SVFFilterEngine<float>, SVFCoefficients<double>>(name, 2, bandSettings, options);
+        });
+
+        if (options.includeDouble)
+            add("engine/bands/biquad-double/" + juce::String(numActiveBands), [&](const juce::String& name)
+            {
+                return benchmarkEngine<double, SIMDFilterEngine<double>, BiquadCoefficients<double>>(name, 2, bandSettings, options);
+            });
+    }
+}
+
+//==============================================================================
+juce::var toJson(const std::vector<Result>& results)
+{
+    juce::Array<juce::var> entries;
+
+    for (const auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("name", result.name);
+        entry->setProperty("unit", result.unit);
+        entry->setProperty("ns", result.nanoseconds);
+        entry->setProperty("allocationsPerCall", result.allocationsPerCall);
+        entry->setProperty("bytesPerCall", result.bytesPerCall);
+        entries.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    root->setProperty("results", entries);
+    return juce::var(root);
+}
+
+// 기준 파일과 비교해서 느려졌거나 할당이 늘어난 항목 수를 반환
+int compareWithBaseline(const std::vector<Result>& results, const juce::var& baseline, double tolerance)
+{
+    std::map<juce::String, const juce::var*> baselineResults;
+
+    if (auto* entries = baseline["results"].getArray())
+        for (const auto& entry : *entries)
+            baselineResults[entry["name"].toString()] = &entry;
+
+    auto numRegressions = 0, numMissing = 0;
+
+    for (const auto& result : results)
+    {
+        const auto found = baselineResults.find(result.name);
+
+        if (found == baselineResults.end())
+        {
+            ++numMissing;
+            continue;
+        }
+
+        const auto& entry = *found->second;
+        const auto baselineNanoseconds = (double) entry["ns"];
+        const auto baselineAllocations = (double) entry["allocationsPerCall"];
+
+        const auto slower = result.nanoseconds > baselineNanoseconds * (1.0 + tolerance);
+        const auto allocates = result.allocationsPerCall > baselineAllocations;
+
+        if (slower || allocates)
+        {
+            std::cout << "REGRESSION  " << result.name
+                      << "  ns " << baselineNanoseconds << " -> " << result.nanoseconds
+                      << "  allocations " << baselineAllocations << " -> " << result.allocationsPerCall << std::endl;
+            ++numRegressions;
+        }
+    }
+
+    // 기준 파일에 없는 항목은 비교하지 못했으므로 알려 줌
+    if (numMissing > 0)
+        std::cout << numMissing << " results have no baseline entry" << std::endl;
+
+    return numRegressions;
+}
+
+void printUsage()
+{
+    std::cout << "usage: normalEQBenchmark [--output <json>] [--baseline <json>] [--tolerance <0.1>]" << std::endl
+              << "                         [--filter <substring>] [--seconds <0.5>] [--double] [--full]" << std::endl;
+}
+
+} // namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    Options options;
+    juce::File outputFile, baselineFile;
+    auto tolerance = 0.1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String argument(argv[i]);
+        const auto hasValue = i + 1 < argc;
+
+        if (argument == "--output" && hasValue)
+            outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if (argument == "--baseline" && hasValue)
+            baselineFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        else if (argument == "--tolerance" && hasValue)
+            tolerance = juce::String(argv[++i]).getDoubleValue();
+        else if (argument == "--filter" && hasValue)
+            options.filter = argv[++i];
+        else if (argument == "--seconds" && hasValue)
+            options.seconds = juce::jmax(0.001, juce::String(argv[++i]).getDoubleValue());
+        else if (argument == "--double")
+            options.includeDouble = true;
+        else if (argument == "--full")
+            options.fullSweep = true;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    const auto designError = checkDesignAccuracy();
+    std::cout << "design accuracy  max error " << designError << "  tolerance " << designTolerance << std::endl;
+
+    if (designError > designTolerance)
+    {
+        std::cerr << "designed coefficients differ from juce::dsp::FilterDesign" << std::endl;
+        return 3;
+    }
+
+    const auto engineError = checkSidePlacedEngines();
+    std::cout << "side-placed svf vs biquad  max error " << engineError << "  tolerance " << engineTolerance << std::endl;
+
+    if (engineError > engineTolerance)
+    {
+        std::cerr << "svf engine output differs from the biquad engine for side-placed bands" << std::endl;
+        return 3;
+    }
+
+    std::vector<Result> results;
+    runDesignBenchmarks(results, options);
+    runEngineBenchmarks(results, options);
+    runProcessBlockBenchmarks(results, options);
+    runEditorBenchmarks(results, options);
+
+    for (const auto& result : results)
+        std::cout << result.name << "  " << result.nanoseconds << " ns/" << result.unit
+                  << "  " << result.allocationsPerCall << " allocations/call"
+                  << "  " << result.bytesPerCall << " bytes/call" << std::endl;
+
+    const auto json = toJson(results);
+
+    if (outputFile != juce::File() && ! outputFile.replaceWithText(juce::JSON::toString(json)))
+    {
+        std::cerr << "cannot write " << outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    if (baselineFile != juce::File())
+    {
+        const auto baseline = juce::JSON::parse(baselineFile);
+
+        if (! baseline.isObject())
+        {
+            std::cerr << "cannot read baseline " << baselineFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        if (compareWithBaseline(results, baseline, tolerance) > 0)
+            return 2;
+    }
+
+    return 0;
+}